@@ -3,11 +3,14 @@
 #include <cctype>           // provides toupper
 #include <iostream>         // provides cout and cin
 #include <cstdlib>          // provides EXIT_SUCCESS and size_t
-#include "DPQueue.h"        // with value_type defined as int
+#include "DPQueue.h"        // provides p_queue template
 
 using namespace std;
 using namespace CS3358_SP2019_A7;
 
+// PQ of integer data with (default) size_t priorities
+typedef p_queue<int> int_p_queue;
+
 // PROTOTYPES for functions used by this test program:
 void print_menu();
 // Pre:  (none)
@@ -24,17 +27,17 @@ int get_data();
 // Post: The user has been prompted to enter an integer. The number
 // has been read, echoed to the screen, and returned by the function.
 
-p_queue::size_type get_priority();
+int_p_queue::priority_type get_priority();
 // Pre:  (none)
 // Post: The user has been prompted to enter an integer. The number
 // has been read, echoed to the screen, and returned by the function.
 
 int main()
 {
-    p_queue test; // PQ to perform test on
+    int_p_queue test; // PQ to perform test on
     char choice;  // command character entered by user
     int data;     // PQ item data entered by user
-    p_queue::size_type priority; // PQ item priority entered by user
+    int_p_queue::priority_type priority; // PQ item priority entered by user
     
     cout << "I have created an empty p_queue (PQ)." << endl;
     cout << "The data of an item of this PQ will be an integer,\n";
@@ -57,9 +60,8 @@ int main()
             case 'D':
                 if ( !test.empty() )
                 {
-                    cout << "Item " << test.front() << " has been dequeued."
+                    cout << "Item " << test.pop() << " has been dequeued."
                     << endl;
-                    test.pop();
                 }
                 else
                     cout << "PQ is empty, nothing to dequeue." << endl;
@@ -136,9 +138,9 @@ int get_data()
     return number;
 }
 
-p_queue::size_type get_priority()
+int_p_queue::priority_type get_priority()
 {
-    p_queue::size_type priority;
+    int_p_queue::priority_type priority;
     char oneChar;
     bool done = true;
     
@@ -1,30 +1,69 @@
 // FILE: DPQueue.h
-// CLASS PROVIDED: p_queue (priority queue ADT)
+// TEMPLATE CLASS PROVIDED: p_queue<T, Priority, Compare, Allocator, Arity>
+//   (priority queue ADT)
+// TEMPLATE ALIAS PROVIDED: d_ary_p_queue<Arity, T, Priority, Compare>
+//   (p_queue with Arity children per item and the default allocator)
+//
+// TEMPLATE PARAMETERS for the p_queue class:
+//   T
+//     The data type of the items in the p_queue. It may be any of the
+//     C++ built-in types (int, char, etc.), or a class with a move
+//     constructor (and move assignment). A copy constructor (and copy
+//     assignment) is needed only if p_queue objects with T items are
+//     copied, or items are pushed by copy; so move-only types (e.g.,
+//     std::unique_ptr) may be stored.
+//   Priority (default: size_t)
+//     The data type of the priority associated with each item in the
+//     p_queue; it is copied and compared (with Compare) only.
+//   Compare (default: std::less<Priority>)
+//     Function object type; Compare()(a, b) returns true if priority
+//     a is lower than priority b, forming a strict weak ordering. The
+//     item with the highest priority is at the front, so the default
+//     gives the same (max-priority first) order as ever, and
+//     std::greater<Priority> gives a min-priority first p_queue.
+//   Allocator (default: std::allocator<T>)
+//     The allocator the heap array is obtained from (rebound to
+//     unsigned char for the array, and to the p_queue's internal item
+//     type for constructing and destroying items).
+//   Arity (default: 2)
+//     The number of children of each item of the heap (2 or more).
+//     The heap array is aligned to 64 bytes and laid out so that the
+//     children of an item start a cache line; so if Arity times the
+//     size of an item (a T and a Priority) is 64 bytes, e.g. 4 for an
+//     int with a size_t priority, or 8 for an int with an int
+//     priority, all of the children of an item are in 1 cache line.
+//     A p_queue of Arity 4 or 8 has half or a third as many levels as
+//     a binary one, so popping from a heap far bigger than the cache
+//     waits for memory that much less often (at the cost of Arity-1
+//     comparisons per level of a pop rather than 2; a push has fewer
+//     levels to climb, too).
 //
 // TYPEDEFS and MEMBER CONSTANTS for the p_queue class:
 //   typedef _____ value_type
 //     p_queue::value_type is the data type of the items in
-//     the p_queue. It may be any of the C++ built-in types
-//     (int, char, etc.), or a class with a default constructor, a
-//     copy constructor, an assignment operator, and a less-than
-//     operator forming a strict weak ordering.
+//     the p_queue (T).
+//
+//   typedef _____ priority_type
+//     p_queue::priority_type is the data type of the priority
+//     associated with each item in the p_queue (Priority).
 //
 //   typedef _____ size_type
 //     p_queue::size_type is the data type considered best-suited
 //     for any variable meant for counting and sizing (as well as
 //     array-indexing) purposes; e.g.: it is the data type for a
 //     variable representing how many items are in the p_queue.
-//     It is also the data type of the priority associated with
-//     each item in the p_queue
 //
 //   static const size_type DEFAULT_CAPACITY = _____
 //    p_queue::DEFAULT_CAPACITY is the default initial capacity of a
 //    p_queue that is created by the default constructor.
 //
 // CONSTRUCTOR for the p_queue class:
-//   p_queue(size_type initial_capacity = DEFAULT_CAPACITY)
+//   p_queue(size_type initial_capacity = DEFAULT_CAPACITY,
+//           const Compare& comp = Compare(),
+//           const Allocator& alloc = Allocator())
 //     Pre:  initial_capacity > 0
-//     Post: The p_queue has been initialized to an empty p_queue.
+//     Post: The p_queue has been initialized to an empty p_queue
+//       that orders priorities with comp and allocates from alloc.
 //       The push function will work efficiently (without allocating
 //       new memory) until this capacity is reached.
 //     Note: If Pre is not met, initial_capacity will be adjusted to
@@ -37,16 +76,61 @@
 //       is to ensure no attempt is made at allocating memory that's
 //       0 in amount).
 //
+//   template <class InputIterator>
+//   p_queue(InputIterator first, InputIterator last,
+//           const Compare& comp = Compare(),
+//           const Allocator& alloc = Allocator())
+//     Pre:  [first, last) is a range of objects with members first
+//       (the data) and second (the priority) of the items to be in
+//       the p_queue, e.g. std::pair<T, Priority> objects.
+//     Post: The p_queue has been initialized to a p_queue of those
+//       items that orders priorities with comp and allocates from
+//       alloc, as if by push_range(first, last) on an empty p_queue.
+//
+//   p_queue(p_queue&& src)
+//     Pre:  (none)
+//     Post: The p_queue has taken over the items (and heap array) of
+//       src, which is left an empty p_queue that allocates anew on
+//       its next push. No item is copied or moved.
+//
 // MODIFICATION MEMBER FUNCTIONS for the p_queue class:
-//   void push(const value_type& entry, size_type priority)
+//   void push(const value_type& entry, const priority_type& priority)
 //     Pre:  (none)
 //     Post: A new copy of item with the specified data and priority
 //           has been added to the p_queue.
 //
-//   void pop()
+//   void push(value_type&& entry, const priority_type& priority)
+//     Pre:  (none)
+//     Post: A new item with the specified priority, whose data has
+//           been moved from entry, has been added to the p_queue.
+//
+//   template <class... Args>
+//   void emplace(const priority_type& priority, Args&&... args)
+//     Pre:  (none)
+//     Post: A new item with the specified priority, whose data has
+//           been constructed in place from args, has been added to
+//           the p_queue.
+//
+//   template <class InputIterator>
+//   void push_range(InputIterator first, InputIterator last)
+//     Pre:  [first, last) is a range as for the range constructor.
+//     Post: An item has been added to the p_queue for each object in
+//           [first, last), with the data of its first member (copied,
+//           or moved if *first is an rvalue, as with a
+//           std::move_iterator) and the priority of its second.
+//     Note: If [first, last) is a range of forward iterators, the
+//           array is grown (at most) once to fit all of the items.
+//           If there are at least as many new items as old ones, the
+//           heap is rebuilt from the bottom up (Floyd's method) in
+//           time linear in size(), rather than pushing the items one
+//           at a time in O(log size()) each. If adding an item
+//           throws, the p_queue is left as it was before the call.
+//
+//   value_type pop()
 //     Pre:  size() > 0.
 //     Post: The highest priority item has been removed from the
-//           p_queue. (If several items have the equal priority,
+//           p_queue, and its data (moved out of the p_queue) has
+//           been returned. (If several items have the equal priority,
 //           then the implementation may decide which one to remove.)
 //
 // CONSTANT MEMBER FUNCTIONS for the p_queue class:
@@ -55,7 +139,7 @@
 //     Post: The return value is the total number of items in the
 //           p_queue.
 //
-//   value_type front() const
+//   const value_type& front() const
 //     Pre:  size() > 0.
 //     Post: The return value is the data of the highest priority
 //           item in the p_queue, but the p_queue is unchanged.
@@ -69,60 +153,137 @@
 //
 // VALUE SEMANTICS for the p_queue class:
 //   Assignments and the copy constructor may be used with p_queue
-//   objects.
+//   objects whose value_type can be copied; move assignment and the
+//   move constructor may be used with any p_queue objects. The move
+//   constructor never throws, nor does move assignment when the
+//   allocator propagates on move assignment or is always equal (as
+//   std::allocator is); otherwise it may have to allocate an array
+//   and move the items into it one by one.
 
 #ifndef D_P_QUEUE_H
 #define D_P_QUEUE_H
 
-#include <cstdlib> // provides size_t
+#include <cstdlib>    // provides size_t
+#include <cstdint>    // provides uintptr_t
+#include <functional> // provides less
+#include <iterator>   // provides iterator_traits, distance
+#include <memory>     // provides allocator, allocator_traits
+#include <type_traits> // provides is_nothrow_move_assignable
+#include <utility>    // provides move, forward
 
 namespace CS3358_SP2019_A7
 {
+    template <class T, class Priority = size_t,
+              class Compare = std::less<Priority>,
+              class Allocator = std::allocator<T>, size_t Arity = 2>
     class p_queue
     {
     public:
         // TYPEDEFS and MEMBER CONSTANTS
-        typedef int value_type;
+        typedef T value_type;
+        typedef Priority priority_type;
+        typedef Compare priority_compare;
+        typedef Allocator allocator_type;
         typedef size_t size_type;
         static const size_type DEFAULT_CAPACITY = 1;
+        static const size_type ARITY = Arity;
         // CONSTRUCTORS AND DESTRUCTOR
-        p_queue(size_type initial_capacity = DEFAULT_CAPACITY);
+        p_queue(size_type initial_capacity = DEFAULT_CAPACITY,
+                const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator());
+        template <class InputIterator>
+        p_queue(InputIterator first, InputIterator last,
+                const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator());
         p_queue(const p_queue& src);
+        p_queue(p_queue&& src) noexcept;
         ~p_queue();
         // MODIFICATION MEMBER FUNCTIONS
         p_queue& operator=(const p_queue& rhs);
-        void push(const value_type& entry, size_type priority);
-        void pop();
+        p_queue& operator=(p_queue&& rhs) noexcept(NOTHROW_MOVE_ASSIGN);
+        void push(const value_type& entry, const priority_type& priority);
+        void push(value_type&& entry, const priority_type& priority);
+        template <class... Args>
+        void emplace(const priority_type& priority, Args&&... args);
+        template <class InputIterator>
+        void push_range(InputIterator first, InputIterator last);
+        value_type pop();
         // CONSTANT MEMBER FUNCTIONS
         size_type size() const;
         bool empty() const;
-        value_type front() const;
+        const value_type& front() const;
         // EXTRA CONSTANT MEMBER FUNCTION FOR DEBUG PRINTING
         void print_tree(const char message[] = "", size_type i = 0) const;
         void print_array(const char message[] = "") const;
-        
+
     private:
+        // tag selecting ItemType's in-place constructor
+        struct in_place_tag { };
         // STRUCT to store information about one item in the p_queue
         struct ItemType
         {
             value_type data;
-            size_type priority;
+            priority_type priority;
+            template <class... Args>
+            ItemType(in_place_tag, const priority_type& p, Args&&... args)
+            : data(std::forward<Args>(args)...), priority(p) { }
         };
+        typedef typename std::allocator_traits<Allocator>::template
+            rebind_alloc<ItemType> item_allocator;
+        typedef std::allocator_traits<item_allocator> item_traits;
+        // true if move assignment always takes over rhs's array (so
+        // neither allocates nor moves an item, and can't throw)
+        static const bool NOTHROW_MOVE_ASSIGN =
+            (item_traits::propagate_on_container_move_assignment::value
+             || item_traits::is_always_equal::value)
+            && std::is_nothrow_move_assignable<Compare>::value;
+        typedef typename std::allocator_traits<Allocator>::template
+            rebind_alloc<unsigned char> byte_allocator;
+        typedef std::allocator_traits<byte_allocator> byte_traits;
         // PRIVATE MEMBER VARIABLES
         ItemType *heap;
+        unsigned char *storage; // memory heap's array is in
         size_type capacity;
         size_type used;
+        Compare compare;
+        item_allocator alloc;
+        // smallest capacity a full p_queue grows to (doubling after that)
+        static const size_type MIN_GROWTH = 16;
+        // size of the top of the heap that sift_down picks children in
+        // without branching (about what stays in L2 cache)
+        static const size_type BRANCHLESS_BYTES = 256 * 1024;
+        // size (and alignment) of a cache line
+        static const size_type CACHE_LINE = 64;
+        static_assert(Arity >= 2, "a p_queue's items need 2 or more children");
+        static_assert(alignof(ItemType) <= CACHE_LINE,
+                      "a p_queue's items can't be aligned beyond a cache line");
         // HELPER FUNCTIONS
+        ItemType* allocate_heap(size_type n, unsigned char*& raw);
+        void deallocate_heap(unsigned char* raw, size_type n);
         void resize(size_type new_capacity);
-        bool is_leaf(size_type i) const;
+        void destroy_items();
+        void heapify();
+        template <class InputIterator>
+        static size_type range_size(InputIterator first, InputIterator last,
+                                    std::input_iterator_tag);
+        template <class ForwardIterator>
+        static size_type range_size(ForwardIterator first, ForwardIterator last,
+                                    std::forward_iterator_tag);
+        void sift_up(size_type i);
+        void sift_down(size_type i);
+        size_type best_child(size_type first, size_type count) const;
+        size_type best_child_branchless(size_type first) const;
+        void prefetch(size_type first, size_type count) const;
         size_type parent_index(size_type i) const;
-        size_type parent_priority(size_type i) const;
-        size_type big_child_index(size_type i) const;
-        size_type big_child_priority(size_type i) const;
-        void swap_with_parent(size_type i);
+        size_type depth(size_type i) const;
     };
-}
 
-#endif
+    // p_queue with Arity children per item and the default allocator
+    template <size_t Arity, class T, class Priority = size_t,
+              class Compare = std::less<Priority> >
+    using d_ary_p_queue = p_queue<T, Priority, Compare, std::allocator<T>, Arity>;
+}
 
+#include "DPQueue.template" // Compiler inclusion
 
+#endif
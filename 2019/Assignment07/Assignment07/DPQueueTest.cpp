@@ -0,0 +1,178 @@
+// FILE: DPQueueTest.cpp
+// A (non-interactive) test program for the pop order of p_queue with
+// 2, 3, 4 and 8 children per item (Arity).
+// (kept separate from the Assignment07 target since it has its own
+// main; build with e.g.
+//   g++ -std=c++14 -g DPQueueTest.cpp
+// and run it as DPQueueTest [runs], runs (default 5000) being the # of
+// random queues tried per test case and Arity; a misplaced item may
+// only show up in one queue out of thousands.)
+// Each queue is filled with random priorities (many of them equal)
+// and emptied, and the priorities popped are compared with the same
+// priorities sorted (a reference that is right by construction); the
+// sizes go up to a few hundred items, so that the last parent has
+// every possible # of children. The test cases are
+//   - push:     pushes, then pops until the queue is empty
+//   - range:    the range constructor and push_range, then pops
+//   - mixed:    pushes and pops in random order, each pop compared
+//               with the highest priority of the reference multiset
+// Each test case and Arity is reported as passed or failed (with the
+// first run that failed); the program exits with EXIT_FAILURE if any
+// of them failed.
+#include <algorithm>        // provides sort
+#include <cstdlib>          // provides EXIT_SUCCESS, EXIT_FAILURE, size_t, atoi
+#include <functional>       // provides greater, less
+#include <iostream>         // provides cout
+#include <random>           // provides mt19937, uniform_int_distribution
+#include <set>              // provides multiset
+#include <utility>          // provides pair
+#include <vector>           // provides vector
+#include "DPQueue.h"        // provides p_queue, d_ary_p_queue templates
+
+using namespace std;
+using namespace CS3358_SP2019_A7;
+
+// PROTOTYPES for functions used by this test program:
+template <size_t Arity>
+bool test_push(mt19937& rng);
+template <size_t Arity>
+bool test_range(mt19937& rng);
+template <size_t Arity>
+bool test_mixed(mt19937& rng);
+// Pre:  (none)
+// Post: One random queue of d_ary_p_queue<Arity, int, int> has been
+// tested with rng, and the return value is true if every item came
+// out in order, otherwise false.
+
+template <size_t Arity>
+size_t run_cases(size_t runs);
+// Pre:  (none)
+// Post: Each test case has been run runs times for Arity (the
+// random numbers seeded with the run # so that a failure can be
+// repeated), and reported to cout; the return value is the # of test
+// cases that failed.
+
+template <size_t Arity>
+bool pops_sorted(d_ary_p_queue<Arity, int, int>& pq, vector<int> priorities);
+// Pre:  priorities are the priorities of the items of pq.
+// Post: pq has been emptied by popping all of its items, and the
+// return value is true if their priorities came out as priorities
+// sorted in decreasing order, with the data of each item equal to its
+// priority, otherwise false.
+
+int main(int argc, char* argv[])
+{
+    size_t runs = argc > 1 ? size_t(atoi(argv[1])) : size_t(5000);
+    size_t failedCases = run_cases<2>(runs) + run_cases<3>(runs)
+                         + run_cases<4>(runs) + run_cases<8>(runs);
+    cout << failedCases << " test case(s) failed" << endl;
+    return failedCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+template <size_t Arity>
+size_t run_cases(size_t runs)
+{
+    struct
+    {
+        const char* name;
+        bool (*run)(mt19937&);
+    } cases[] = { { "push",  test_push<Arity> },
+                  { "range", test_range<Arity> },
+                  { "mixed", test_mixed<Arity> } };
+    size_t failedCases = 0;
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+    {
+        size_t r = 0;
+        for ( ; r < runs; ++r)
+        {
+            mt19937 rng(unsigned(r + 1));
+            if (!cases[c].run(rng))
+                break;
+        }
+        cout << (r == runs ? "passed: " : "FAILED: ") << cases[c].name
+             << ", Arity " << Arity;
+        if (r != runs)
+        {
+            cout << " (run " << r + 1 << ")";
+            ++failedCases;
+        }
+        cout << endl;
+    }
+    return failedCases;
+}
+
+template <size_t Arity>
+bool pops_sorted(d_ary_p_queue<Arity, int, int>& pq, vector<int> priorities)
+{
+    sort(priorities.begin(), priorities.end(), greater<int>());
+    bool inOrder = pq.size() == priorities.size();
+    for (size_t i = 0; !pq.empty(); ++i)
+    {
+        int data = pq.pop();
+        if (i >= priorities.size() || data != priorities[i])
+            inOrder = false;
+    }
+    return inOrder;
+}
+
+template <size_t Arity>
+bool test_push(mt19937& rng)
+{
+    uniform_int_distribution<int> size(0, 400), priority(0, 99);
+    d_ary_p_queue<Arity, int, int> pq;
+    vector<int> priorities(size_t(size(rng)));
+
+    for (size_t i = 0; i < priorities.size(); ++i)
+    {
+        priorities[i] = priority(rng);
+        pq.push(priorities[i], priorities[i]);
+    }
+    return pops_sorted(pq, priorities);
+}
+
+template <size_t Arity>
+bool test_range(mt19937& rng)
+{
+    uniform_int_distribution<int> size(0, 400), priority(0, 99);
+    vector<pair<int, int> > items(size_t(size(rng)));
+    vector<int> priorities;
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        int p = priority(rng);
+        items[i] = make_pair(p, p);
+        priorities.push_back(p);
+    }
+    // The first half into a new queue, the rest pushed onto it (one
+    // by one or by rebuilding the heap, whichever push_range picks)
+    size_t half = items.size() / 2;
+    d_ary_p_queue<Arity, int, int> pq(items.begin(), items.begin() + half);
+    pq.push_range(items.begin() + half, items.end());
+    return pops_sorted(pq, priorities);
+}
+
+template <size_t Arity>
+bool test_mixed(mt19937& rng)
+{
+    uniform_int_distribution<int> steps(0, 1000), priority(0, 99), coin(0, 2);
+    d_ary_p_queue<Arity, int, int> pq;
+    multiset<int, greater<int> > reference; // highest priority first
+
+    for (int s = steps(rng); s > 0; --s)
+    {
+        if (coin(rng) != 0 || reference.empty()) // Pushing 2 of 3 times
+        {
+            int p = priority(rng);
+            pq.push(p, p);
+            reference.insert(p);
+        }
+        else
+        {
+            if (pq.empty() || pq.pop() != *reference.begin())
+                return false;
+            reference.erase(reference.begin());
+        }
+    }
+    return pops_sorted(pq, vector<int>(reference.begin(), reference.end()));
+}
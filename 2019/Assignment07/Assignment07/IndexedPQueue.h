@@ -0,0 +1,202 @@
+// FILE: IndexedPQueue.h
+// TEMPLATE CLASS PROVIDED: indexed_p_queue<T, Priority, Compare, Allocator>
+//   (priority queue ADT whose items can be found again by handle)
+//
+// An indexed_p_queue is a (binary) p_queue that gives each item pushed
+// onto it a handle, by which the item can later be looked up, have its
+// priority changed or be removed, wherever it is in the heap, in
+// O(log n) time. Changing the priority of a queued item this way
+// replaces pushing a duplicate of it and skipping the stale one when
+// it comes to the front (e.g., decrease-key in Dijkstra's algorithm).
+//
+// TEMPLATE PARAMETERS for the indexed_p_queue class:
+//   T, Priority, Compare, Allocator
+//     As for p_queue (see DPQueue.h): the item and priority types,
+//     the function object ordering priorities (the item with the
+//     highest priority is at the front; std::greater<Priority> gives a
+//     min-priority first queue), and the allocator the item array and
+//     the handle tables are obtained from (rebound to their types).
+//
+// TYPEDEFS and MEMBER CONSTANTS for the indexed_p_queue class:
+//   typedef _____ value_type
+//   typedef _____ priority_type
+//   typedef _____ size_type
+//     As for p_queue.
+//
+//   struct handle_type
+//     indexed_p_queue::handle_type identifies one item pushed onto an
+//     indexed_p_queue. It stays valid (refers to the same item) until
+//     that item is popped or erased, however the heap is rearranged
+//     meanwhile; after that, contains returns false for it, even if
+//     the space it referred to has been reused for another item. A
+//     default constructed handle_type refers to no item.
+//
+//   static const size_type DEFAULT_CAPACITY = _____
+//     indexed_p_queue::DEFAULT_CAPACITY is the default initial
+//     capacity of an indexed_p_queue created by the default
+//     constructor.
+//
+// CONSTRUCTOR for the indexed_p_queue class:
+//   indexed_p_queue(size_type initial_capacity = DEFAULT_CAPACITY,
+//                   const Compare& comp = Compare(),
+//                   const Allocator& alloc = Allocator())
+//     Pre:  (none)
+//     Post: The indexed_p_queue has been initialized to an empty
+//       indexed_p_queue that orders priorities with comp and allocates
+//       from alloc. The push function will work efficiently (without
+//       allocating new memory) until this capacity is reached.
+//
+// MODIFICATION MEMBER FUNCTIONS for the indexed_p_queue class:
+//   handle_type push(const value_type& entry, const priority_type& priority)
+//   handle_type push(value_type&& entry, const priority_type& priority)
+//   template <class... Args>
+//   handle_type emplace(const priority_type& priority, Args&&... args)
+//     Pre:  (none)
+//     Post: As for p_queue, and the handle of the new item has been
+//           returned.
+//
+//   value_type pop()
+//     Pre:  size() > 0.
+//     Post: As for p_queue (the handle of the item removed is no
+//           longer valid).
+//
+//   void update_priority(const handle_type& handle,
+//                        const priority_type& priority)
+//     Pre:  contains(handle)
+//     Post: The priority of the item of handle has been set to
+//           priority (and the item moved up or down the heap to
+//           match); handle still refers to it.
+//
+//   value_type erase(const handle_type& handle)
+//     Pre:  contains(handle)
+//     Post: The item of handle has been removed from the
+//           indexed_p_queue, and its data (moved out of the
+//           indexed_p_queue) has been returned. handle is no longer
+//           valid.
+//
+// CONSTANT MEMBER FUNCTIONS for the indexed_p_queue class:
+//   size_type size() const
+//   bool empty() const
+//   const value_type& front() const
+//     As for p_queue.
+//
+//   const priority_type& front_priority() const
+//     Pre:  size() > 0.
+//     Post: The return value is the priority of the item whose data
+//           front returns.
+//
+//   bool contains(const handle_type& handle) const
+//     Pre:  (none)
+//     Post: The return value is true if handle was returned by a push
+//           (or emplace) of this indexed_p_queue and its item has not
+//           been popped or erased since, otherwise false.
+//
+//   const priority_type& priority(const handle_type& handle) const
+//     Pre:  contains(handle)
+//     Post: The return value is the priority of the item of handle.
+//
+// VALUE SEMANTICS for the indexed_p_queue class:
+//   Assignments and the copy constructor may be used with
+//   indexed_p_queue objects whose value_type can be copied (the copy's
+//   items have the same handles as the original's); move assignment
+//   and the move constructor may be used with any indexed_p_queue
+//   objects (the handles of the items go along with them).
+
+#ifndef INDEXED_P_QUEUE_H
+#define INDEXED_P_QUEUE_H
+
+#include <cstdlib>    // provides size_t
+#include <functional> // provides less
+#include <memory>     // provides allocator, allocator_traits
+#include <utility>    // provides move, forward
+#include <vector>     // provides vector
+
+namespace CS3358_SP2019_A7
+{
+    template <class T, class Priority = size_t,
+              class Compare = std::less<Priority>,
+              class Allocator = std::allocator<T> >
+    class indexed_p_queue
+    {
+    public:
+        // TYPEDEFS and MEMBER CONSTANTS
+        typedef T value_type;
+        typedef Priority priority_type;
+        typedef Compare priority_compare;
+        typedef Allocator allocator_type;
+        typedef size_t size_type;
+        static const size_type DEFAULT_CAPACITY = 1;
+        struct handle_type
+        {
+            size_type slot;       // index into the slot table
+            size_type generation; // # of items the slot had before
+            handle_type() : slot(size_type(-1)), generation(0) { }
+            handle_type(size_type s, size_type g) : slot(s), generation(g) { }
+        };
+        // CONSTRUCTOR
+        indexed_p_queue(size_type initial_capacity = DEFAULT_CAPACITY,
+                        const Compare& comp = Compare(),
+                        const Allocator& alloc = Allocator());
+        // MODIFICATION MEMBER FUNCTIONS
+        handle_type push(const value_type& entry, const priority_type& priority);
+        handle_type push(value_type&& entry, const priority_type& priority);
+        template <class... Args>
+        handle_type emplace(const priority_type& priority, Args&&... args);
+        value_type pop();
+        void update_priority(const handle_type& handle, const priority_type& priority);
+        value_type erase(const handle_type& handle);
+        // CONSTANT MEMBER FUNCTIONS
+        size_type size() const;
+        bool empty() const;
+        const value_type& front() const;
+        const priority_type& front_priority() const;
+        bool contains(const handle_type& handle) const;
+        const priority_type& priority(const handle_type& handle) const;
+
+    private:
+        // tag selecting ItemType's in-place constructor
+        struct in_place_tag { };
+        // STRUCT to store information about one item in the heap
+        struct ItemType
+        {
+            value_type data;
+            priority_type priority;
+            size_type slot; // the item's slot in the slot table
+            template <class... Args>
+            ItemType(in_place_tag, const priority_type& p, size_type s,
+                     Args&&... args)
+            : data(std::forward<Args>(args)...), priority(p), slot(s) { }
+        };
+        // STRUCT to store where the item a handle refers to is
+        struct SlotType
+        {
+            size_type position;   // index of the item in heap, or NOT_QUEUED
+            size_type generation; // bumped each time the item goes away
+            SlotType() : position(NOT_QUEUED), generation(0) { }
+        };
+        typedef typename std::allocator_traits<Allocator>::template
+            rebind_alloc<ItemType> item_allocator;
+        typedef typename std::allocator_traits<Allocator>::template
+            rebind_alloc<SlotType> slot_allocator;
+        typedef typename std::allocator_traits<Allocator>::template
+            rebind_alloc<size_type> index_allocator;
+        // PRIVATE MEMBER VARIABLES
+        std::vector<ItemType, item_allocator> heap;
+        std::vector<SlotType, slot_allocator> slots;
+        std::vector<size_type, index_allocator> freeSlots; // slots not in use
+        Compare compare;
+        // position of the item of a slot not in use
+        static const size_type NOT_QUEUED = size_type(-1);
+        // HELPER FUNCTIONS
+        value_type remove(size_type i);
+        void restore(size_type i);
+        void sift_up(size_type i);
+        void sift_down(size_type i);
+        void place(size_type i, ItemType&& item);
+        size_type parent_index(size_type i) const;
+    };
+}
+
+#include "IndexedPQueue.template" // Compiler inclusion
+
+#endif
@@ -0,0 +1,213 @@
+// FILE: IndexedPQueueTest.cpp
+// A (non-interactive) test program for the indexed_p_queue ADT.
+// (kept separate from the Assignment07 target since it has its own
+// main; build with e.g.
+//   g++ -std=c++14 -g IndexedPQueueTest.cpp
+// and run it as IndexedPQueueTest.)
+// Each test case below is run in turn and reported as passed or
+// failed (with the checks that failed); the program exits with
+// EXIT_FAILURE if any case failed. The cases cover:
+//   - push:         handles of pushed items, front and priorities
+//   - raise:        update_priority moving an item up to the front
+//   - lower:        update_priority moving the front item down
+//   - erase:        erase of an item from the middle of the heap
+//   - stale handle: a handle of an erased (or popped) item whose slot
+//                   has been reused by a later push
+#include <cstdlib>          // provides EXIT_SUCCESS, EXIT_FAILURE, size_t
+#include <iostream>         // provides cout
+#include <vector>           // provides vector
+#include "IndexedPQueue.h"  // provides indexed_p_queue template
+
+using namespace std;
+using namespace CS3358_SP2019_A7;
+
+// PQ of integer data with (default) size_t priorities
+typedef indexed_p_queue<int> int_i_p_queue;
+typedef int_i_p_queue::handle_type handle;
+
+// # of checks that failed in the test case being run
+static size_t failures = 0;
+
+// PROTOTYPES for functions used by this test program:
+void check(bool condition, const char* what);
+// Pre:  (none)
+// Post: If condition is false, what has been written to cout as a
+// failed check and failures has been incremented.
+
+bool pops_in_order(int_i_p_queue& pq, const vector<int>& expected);
+// Pre:  (none)
+// Post: pq has been emptied by popping all of its items, and the
+// return value is true if their data came out as expected (in that
+// order) with priorities that never went up, otherwise false.
+
+void test_push();
+void test_raise();
+void test_lower();
+void test_erase();
+void test_stale_handle();
+// Pre:  (none)
+// Post: The test case has been run, its failed checks written to
+// cout and counted in failures.
+
+int main()
+{
+    struct
+    {
+        const char* name;
+        void (*run)();
+    } cases[] = { { "push",         test_push },
+                  { "raise",        test_raise },
+                  { "lower",        test_lower },
+                  { "erase",        test_erase },
+                  { "stale handle", test_stale_handle } };
+    size_t failedCases = 0;
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+    {
+        failures = 0;
+        cases[c].run();
+        cout << (failures == 0 ? "passed: " : "FAILED: ") << cases[c].name
+             << endl;
+        if (failures != 0)
+            ++failedCases;
+    }
+    cout << failedCases << " test case(s) failed" << endl;
+    return failedCases == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        cout << "  check failed: " << what << endl;
+        ++failures;
+    }
+}
+
+bool pops_in_order(int_i_p_queue& pq, const vector<int>& expected)
+{
+    bool inOrder = pq.size() == expected.size();
+    size_t i = 0;
+    while (!pq.empty())
+    {
+        int_i_p_queue::priority_type priority = pq.front_priority();
+        int data = pq.pop();
+        if (i >= expected.size() || data != expected[i]
+            || (!pq.empty() && pq.front_priority() > priority))
+            inOrder = false;
+        ++i;
+    }
+    return inOrder;
+}
+
+void test_push()
+{
+    int_i_p_queue pq;
+    check(pq.empty() && pq.size() == 0, "new queue is empty");
+    check(!pq.contains(handle()), "default handle refers to no item");
+
+    handle h10 = pq.push(10, 10);
+    handle h30 = pq.push(30, 30);
+    handle h20 = pq.push(20, 20);
+    handle h40 = pq.emplace(40, 40);
+    check(pq.size() == 4, "size after 4 pushes");
+    check(pq.front() == 40 && pq.front_priority() == 40,
+          "front is the highest priority item");
+    check(pq.contains(h10) && pq.contains(h20) && pq.contains(h30)
+          && pq.contains(h40), "handles of pushed items are valid");
+    check(pq.priority(h10) == 10 && pq.priority(h20) == 20
+          && pq.priority(h30) == 30 && pq.priority(h40) == 40,
+          "priority of each handle");
+
+    int_i_p_queue::value_type data = pq.pop();
+    check(data == 40 && !pq.contains(h40), "popped item's handle is invalid");
+    check(pq.contains(h10) && pq.priority(h30) == 30,
+          "other handles still valid after pop");
+    check(pops_in_order(pq, vector<int>{ 30, 20, 10 }), "pop order");
+}
+
+void test_raise()
+{
+    int_i_p_queue pq;
+    vector<handle> h;
+    for (int i = 1; i <= 7; ++i)
+        h.push_back(pq.push(i, size_t(i) * 10)); // 10, 20, ... 70
+
+    pq.update_priority(h[0], 100); // Lowest item (a leaf) to the front
+    check(pq.front() == 1 && pq.front_priority() == 100,
+          "raised item is at the front");
+    check(pq.contains(h[0]) && pq.priority(h[0]) == 100,
+          "raised item's handle follows it");
+
+    pq.update_priority(h[2], 55); // 30 to between 50 and 60
+    check(pq.priority(h[2]) == 55, "priority of item raised part way");
+    for (size_t i = 0; i < h.size(); ++i)
+        check(pq.contains(h[i]), "every handle still valid");
+    check(pops_in_order(pq, vector<int>{ 1, 7, 6, 3, 5, 4, 2 }), "pop order");
+}
+
+void test_lower()
+{
+    int_i_p_queue pq;
+    vector<handle> h;
+    for (int i = 1; i <= 7; ++i)
+        h.push_back(pq.push(i, size_t(i) * 10)); // 10, 20, ... 70
+
+    pq.update_priority(h[6], 5); // Front item (the root) to the bottom
+    check(pq.front() == 6 && pq.front_priority() == 60,
+          "next item is at the front after lowering the front");
+    check(pq.contains(h[6]) && pq.priority(h[6]) == 5,
+          "lowered item's handle follows it");
+
+    pq.update_priority(h[5], 35); // 60 to between 30 and 40
+    pq.update_priority(h[3], 40); // Unchanged priority
+    check(pq.front() == 5 && pq.priority(h[5]) == 35,
+          "front after lowering the new front part way");
+    check(pops_in_order(pq, vector<int>{ 5, 4, 6, 3, 2, 1, 7 }), "pop order");
+}
+
+void test_erase()
+{
+    int_i_p_queue pq;
+    vector<handle> h;
+    for (int i = 1; i <= 9; ++i)
+        h.push_back(pq.push(i, size_t(i) * 10)); // 10, 20, ... 90
+
+    // The heap is now 90, 80, 60, 70, 30, 20, 50, 10, 40: 80 is a child
+    // of the root, and the last item (40) moved into its place has to
+    // go down the tree
+    int_i_p_queue::value_type data = pq.erase(h[7]);
+    check(data == 8, "erase returns the erased item's data");
+    check(pq.size() == 8 && !pq.contains(h[7]),
+          "erased item is gone, with its handle");
+    for (size_t i = 0; i < h.size(); ++i)
+        if (i != 7)
+            check(pq.contains(h[i]) && pq.priority(h[i]) == (i + 1) * 10,
+                  "other handles keep their items");
+
+    data = pq.erase(h[1]); // 20, a leaf the (new) last item replaces
+    check(data == 2 && !pq.contains(h[1]), "second erase");
+    pq.update_priority(h[8], 15); // Front to the bottom past the gaps
+    check(pops_in_order(pq, vector<int>{ 7, 6, 5, 4, 3, 9, 1 }), "pop order");
+}
+
+void test_stale_handle()
+{
+    int_i_p_queue pq;
+    handle a = pq.push(1, 10);
+    handle b = pq.push(2, 20);
+
+    check(pq.erase(a) == 1 && !pq.contains(a), "erased handle is invalid");
+    handle c = pq.push(3, 30); // Reuses a's slot
+    check(c.slot == a.slot, "new item reuses the freed slot");
+    check(!pq.contains(a), "stale handle still invalid after slot reuse");
+    check(pq.contains(c) && pq.priority(c) == 30, "new handle is valid");
+
+    check(pq.pop() == 3 && !pq.contains(c), "popped handle is invalid");
+    handle d = pq.push(4, 5); // Reuses the slot once more
+    check(d.slot == a.slot && !pq.contains(a) && !pq.contains(c),
+          "older handles of a slot stay invalid");
+    check(pq.contains(b) && pq.contains(d) && pq.priority(d) == 5,
+          "live handles unaffected");
+    check(pops_in_order(pq, vector<int>{ 2, 4 }), "pop order");
+}
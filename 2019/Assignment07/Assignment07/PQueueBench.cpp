@@ -0,0 +1,234 @@
+// FILE: PQueueBench.cpp
+// Benchmark of p_queue (DPQueue.h) against the original int/size_t
+// p_queue (its push/pop and helpers kept below as legacy_p_queue, the
+// 3 cases of its resize folded into one)
+// (kept separate from the Assignment07 target since it has its own
+// main; build with e.g.
+//   g++ -std=c++14 -O2 -DNDEBUG PQueueBench.cpp
+// and run it as PQueueBench [max_n], max_n (default 1e8) being the
+// largest # of items to try; at 1e8 the queues need about 1.6 GB).
+// For n = 1e3, 1e4, ... up to max_n it reports, for the legacy queue
+// and for p_queue<int> with 2, 4 and 8 children per item (Arity),
+//   - ns/push:   time to push one of n items with random priorities
+//                onto a queue created with the default capacity
+//   - ns/pop:    time to pop one of them, until the queue is empty
+// (each n is repeated so that at least 1e7 items are timed)
+// and then, for binary p_queue<int>, the time (in ms) to load n items
+// from a vector of (data, priority) pairs into a new queue
+//   - push:      with n pushes onto a queue of the default capacity
+//   - range:     with the range constructor (one allocation and a
+//                bottom-up heapify)
+#include "DPQueue.h"
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <utility>
+#include <vector>
+using namespace std;
+
+namespace legacy
+{
+    // the p_queue of DPQueue.cpp before p_queue became a template
+    class legacy_p_queue
+    {
+    public:
+        typedef int value_type;
+        typedef size_t size_type;
+        static const size_type DEFAULT_CAPACITY = 1;
+        legacy_p_queue(size_type initial_capacity = DEFAULT_CAPACITY)
+        : capacity(initial_capacity), used(0)
+        {
+            if (capacity == 0)
+                capacity = DEFAULT_CAPACITY;
+            heap = new ItemType[capacity];
+        }
+        ~legacy_p_queue() { delete [] heap; }
+        void push(const value_type& entry, size_type priority)
+        {
+            if (used == capacity)
+                resize(capacity * 2);
+            size_type newEntryIndex = used;
+            heap[newEntryIndex].data = entry;
+            heap[newEntryIndex].priority = priority;
+            ++used;
+            while(newEntryIndex != 0 && heap[newEntryIndex].priority > parent_priority(newEntryIndex))
+            {
+                swap_with_parent(newEntryIndex);
+                newEntryIndex = parent_index(newEntryIndex);
+            }
+        }
+        void pop()
+        {
+            heap[0] = heap[used-1];
+            --used;
+            if(used == 0)
+                return;
+            size_type newEntryIndex = 0;
+            while(!is_leaf(newEntryIndex) && big_child_priority(newEntryIndex) > heap[newEntryIndex].priority)
+            {
+                newEntryIndex = big_child_index(newEntryIndex);
+                swap_with_parent(newEntryIndex);
+            }
+        }
+        size_type size() const { return used; }
+        bool empty() const { return used == 0; }
+        value_type front() const { assert(size() > 0); return heap[0].data; }
+    private:
+        struct ItemType
+        {
+            value_type data;
+            size_type priority;
+        };
+        ItemType *heap;
+        size_type capacity;
+        size_type used;
+        void resize(size_type new_capacity)
+        {
+            ItemType* tempHeap = heap;
+            size_type tempCap = new_capacity < used ? used : new_capacity;
+            if (tempCap == 0)
+                tempCap = 1;
+            heap = new ItemType[tempCap];
+            for (size_type i = 0; i < used; ++i)
+                heap[i] = tempHeap[i];
+            delete [] tempHeap;
+            capacity = tempCap;
+        }
+        bool is_leaf(size_type i) const
+        { assert(i < used); return !((i*2 + 1) < used); }
+        size_type parent_index(size_type i) const
+        { assert(i > 0); assert(i < used); return((i-1)/2); }
+        size_type parent_priority(size_type i) const
+        { assert(i > 0); assert(i < used); return(heap[parent_index(i)].priority); }
+        size_type big_child_index(size_type i) const
+        {
+            assert(!is_leaf(i));
+            size_type left = 2 * i + 1;
+            size_type right = 2 * i + 2;
+            if (right < used && heap[right].priority > heap[left].priority)
+                return right;
+            else
+                return left;
+        }
+        size_type big_child_priority(size_type i) const
+        { assert(!is_leaf(i)); return(heap[big_child_index(i)].priority); }
+        void swap_with_parent(size_type i)
+        {
+            assert(i > 0 && i < used);
+            ItemType tempItem = heap[i];
+            heap[i] = heap[parent_index(i)];
+            heap[parent_index(i)] = tempItem;
+        }
+    };
+}
+
+// returns the next of a sequence of pseudo-random priorities (xorshift;
+// cheap enough not to swamp the time of a push)
+static inline size_t next_priority(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return size_t(state);
+}
+
+// pushes n items onto a Queue and pops them all, rounds times over,
+// and sets nsPush and nsPop to the average times (in ns) per item
+template <class Queue>
+void TimePushPop(size_t n, size_t rounds, double& nsPush, double& nsPop)
+{
+    chrono::duration<double, nano> pushTime(0), popTime(0);
+    uint64_t state = 88172645463325252ULL;
+    long long sink = 0; // keeps the compiler from dropping the work
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        Queue q;
+        chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i)
+            q.push(int(i), next_priority(state));
+        chrono::steady_clock::time_point mid = chrono::steady_clock::now();
+        while ( ! q.empty() )
+        {
+            sink += q.front();
+            q.pop();
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        pushTime += mid - beg;
+        popTime += end - mid;
+    }
+    if (sink == 1) cout << ' ';
+    nsPush = pushTime.count() / (double(rounds) * n);
+    nsPop = popTime.count() / (double(rounds) * n);
+}
+
+// loads the n (data, priority) pairs of items into a new Queue by
+// pushing them one by one and with the range constructor, and sets
+// msPush and msRange to the times (in ms) each way took
+template <class Queue>
+void TimeLoad(const vector<pair<int, size_t> >& items, double& msPush,
+              double& msRange)
+{
+    long long sink = 0;
+    chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+    {
+        Queue q;
+        for (size_t i = 0; i < items.size(); ++i)
+            q.push(items[i].first, items[i].second);
+        sink += q.front();
+    }
+    chrono::steady_clock::time_point mid = chrono::steady_clock::now();
+    {
+        Queue q(items.begin(), items.end());
+        sink += q.front();
+    }
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    if (sink == 1) cout << ' ';
+    msPush = chrono::duration<double, milli>(mid - beg).count();
+    msRange = chrono::duration<double, milli>(end - mid).count();
+}
+
+// times the queues for n = 1e3 up to max_n (argv[1]) items
+int main(int argc, char* argv[])
+{
+    const size_t MIN_ITEMS_TIMED = 10000000;
+    size_t maxN = argc > 1 ? size_t(atof(argv[1])) : size_t(100000000);
+
+    cout << setw(12) << "" << setw(16) << "legacy" << setw(16) << "binary"
+         << setw(16) << "4-ary" << setw(16) << "8-ary" << endl;
+    cout << setw(12) << "n";
+    for (int q = 0; q < 4; ++q)
+        cout << setw(8) << "push" << setw(8) << "pop";
+    cout << "   (ns/op)" << endl;
+    cout << fixed << setprecision(1);
+    for (size_t n = 1000; n <= maxN; n *= 10)
+    {
+        size_t rounds = n < MIN_ITEMS_TIMED ? MIN_ITEMS_TIMED / n : 1;
+        double push[4], pop[4];
+        TimePushPop<legacy::legacy_p_queue>(n, rounds, push[0], pop[0]);
+        TimePushPop<CS3358_SP2019_A7::d_ary_p_queue<2, int> >(n, rounds, push[1], pop[1]);
+        TimePushPop<CS3358_SP2019_A7::d_ary_p_queue<4, int> >(n, rounds, push[2], pop[2]);
+        TimePushPop<CS3358_SP2019_A7::d_ary_p_queue<8, int> >(n, rounds, push[3], pop[3]);
+        cout << setw(12) << n;
+        for (int q = 0; q < 4; ++q)
+            cout << setw(8) << push[q] << setw(8) << pop[q];
+        cout << endl;
+    }
+
+    cout << endl << setw(12) << "n" << setw(12) << "push" << setw(12) << "range"
+         << "   (ms to load)" << endl;
+    cout << setprecision(2);
+    for (size_t n = 1000; n <= maxN; n *= 10)
+    {
+        vector<pair<int, size_t> > items(n);
+        uint64_t state = 88172645463325252ULL;
+        for (size_t i = 0; i < n; ++i)
+            items[i] = make_pair(int(i), next_priority(state));
+        double push, range;
+        TimeLoad<CS3358_SP2019_A7::p_queue<int> >(items, push, range);
+        cout << setw(12) << n << setw(12) << push << setw(12) << range << endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,46 +1,93 @@
 #include "HashTable.h"
+#include "GroupHashTable.h"
+#include "HashSnapshot.h"
+#include "PerfectHash.h"
+#include "RobinHoodHashTable.h"
+#include "CuckooHashTable.h"
+#include "StripedHashTable.h"
+#include "SpellSuggester.h"
+#include "SpellStream.h"
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstring>
 #include <ctime>
+#include <chrono>
 using namespace std;
 
+// # of suggestions (within 2 edits) listed for a misspelled word
+const SpellSuggester::size_type NUM_SUGGESTIONS = 5;
+
 void MakeAllLowerCase(string& word);
+int CheckFiles(int numFiles, char* fileNames[]);
+template <class Table> int SpellCheck();
+template <class Table> bool LoadDictionary(Table& hTab, const char* fileName);
+bool LoadDictionary(HashTable& hTab, const char* fileName);
+bool LoadDictionary(HashSnapshot& hTab, const char* fileName);
+bool LoadDictionary(PerfectHashTable& hTab, const char* fileName);
+bool LoadDictionary(StripedHashTable& hTab, const char* fileName);
+template <class Table>
+void SearchBatch(const Table& hTab, const string_view* words,
+                 size_t count, bool* found);
+void SearchBatch(const HashTable& hTab, const string_view* words,
+                 size_t count, bool* found);
 
-int main()
+// usage: Assign08 [group | snap | robin | perfect | cuckoo | striped]
+//   (the optional argument selects the GroupHashTable storage engine,
+//    a read-only HashSnapshot, the RobinHoodHashTable storage engine,
+//    a read-only PerfectHashTable, the CuckooHashTable storage engine
+//    or the segmented StripedHashTable instead of the default HashTable)
+// or:    Assign08 check file...
+//   (batch mode: spell checks the text files against the big
+//    dictionary, listing each misspelled word as file:line:column: word)
+int main(int argc, char* argv[])
 {
-    HashTable hTab;
+    if (argc > 1 && strcmp(argv[1], "check") == 0)
+        return CheckFiles(argc - 2, argv + 2);
+    if (argc > 1 && strcmp(argv[1], "group") == 0)
+        return SpellCheck<GroupHashTable>();
+    if (argc > 1 && strcmp(argv[1], "snap") == 0)
+        return SpellCheck<HashSnapshot>();
+    if (argc > 1 && strcmp(argv[1], "robin") == 0)
+        return SpellCheck<RobinHoodHashTable>();
+    if (argc > 1 && strcmp(argv[1], "perfect") == 0)
+        return SpellCheck<PerfectHashTable>();
+    if (argc > 1 && strcmp(argv[1], "cuckoo") == 0)
+        return SpellCheck<CuckooHashTable>();
+    if (argc > 1 && strcmp(argv[1], "striped") == 0)
+        return SpellCheck<StripedHashTable>();
+    return SpellCheck<HashTable>();
+}
+
+// loads the selected dictionary into a Table and spell checks words
+// entered by the user until the user chooses to quit
+template <class Table>
+int SpellCheck()
+{
+    Table hTab;
     cout << "capacity initially: " << hTab.cap() << endl;
     cout << "used initially:     " << hTab.size() << endl;
     char dictOption;
     cout << "select dictionary (s = small, others = big): ";
     cin >> dictOption;
     cin.ignore(9999, '\n');
-    ifstream fin;
-    if (dictOption == 's' || dictOption == 'S')
-        fin.open("dict0.txt", ios::in);
-    else
-        fin.open("dict1.txt", ios::in);
-    if ( fin.fail() )
-    {
-        cerr << "Failed to open dictionary file "
-        << ( (dictOption == 's') ? "dict0.txt" : "dict1.txt" ) << "..."
-        << "\nMake dictionary files accessible and try again ..." << endl;
-        exit(EXIT_FAILURE);
-    }
+    const char* dictName = (dictOption == 's' || dictOption == 'S')
+                           ? "dict0.txt" : "dict1.txt";
     clock_t begLoad;   // for timing hashtable load
     clock_t endLoad;   // for timing hashtable load
     string oneWord;    // holder for word
     cout << "loading dictionary . . ." << endl;
     begLoad = clock();
-    fin >> ws;
-    while ( ! fin.eof() )
+    if ( ! LoadDictionary(hTab, dictName) )
     {
-        fin >> oneWord;
-        if ( ! hTab.exists(oneWord) ) hTab.insert(oneWord);
-        fin >> ws;
+        cerr << "Failed to open dictionary file "
+        << dictName << "..."
+        << "\nMake dictionary files accessible and try again ..." << endl;
+        exit(EXIT_FAILURE);
     }
-    fin.close();
     endLoad = clock() - begLoad;
     cout << "dictionary loaded in "
     << (double)endLoad / ((double)CLOCKS_PER_SEC)
@@ -51,6 +98,18 @@ int main()
     hTab.grading_helper_print(cout);
     hTab.scat_plot(cout);
     
+    SpellSuggester suggester;   // suggestions within 2 edits
+    vector<SpellSuggester::Suggestion> suggestions;
+    cout << "building suggestion index . . ." << endl;
+    begLoad = clock();
+    suggester.load(dictName);
+    endLoad = clock() - begLoad;
+    cout << "suggestion index built in "
+    << (double)endLoad / ((double)CLOCKS_PER_SEC)
+    << " seconds . . ." << endl;
+    cout << "index entries:      " << suggester.index_size() << endl;
+    cout << "index memory (KB):  " << suggester.memory() / 1024 << endl;
+    
     char response;
     do
     {
@@ -63,26 +122,33 @@ int main()
             cout << oneWord << " matches a word in dictionary ~ o ~" << endl;
         else
         {
-            string altWord;
+            // all single-letter substitutions are looked up in one batch
+            typename Table::size_type size = oneWord.size();
+            string altChars;
+            vector<string_view> altWords;
+            altChars.reserve(size * 26 * size);
+            for(typename Table::size_type x = 0; x < size; ++x)
+                for(char c = 'a'; c <= 'z'; ++c)
+                {
+                    altChars += oneWord;
+                    altChars[altChars.size() - size + x] = c;
+                }
+            for(typename Table::size_type i = 0; i < size * 26; ++i)
+                altWords.push_back(string_view(altChars).substr(i * size, size));
+            unique_ptr<bool[]> found(new bool[altWords.size()]);
+            SearchBatch(hTab, altWords.data(), altWords.size(), found.get());
             bool suggLabPrinted = false;
-            HashTable::size_type size = oneWord.size();
-            for(HashTable::size_type x = 0; x < size; ++x)
+            for(typename Table::size_type i = 0; i < altWords.size(); ++i)
             {
-                altWord = oneWord;
-                for(char c = 'a'; c <= 'z'; ++c)
+                if( found[i] )
                 {
-                    altWord[x] = c;
-                    if( hTab.search(altWord) )
+                    if( ! suggLabPrinted)
                     {
-                        if( ! suggLabPrinted)
-                        {
-                            cout << oneWord << " not found in dictionary . . .\n"
-                            << "   near match(es): ";
-                            suggLabPrinted = true;
-                        }
-                        cout << altWord << "  ";
+                        cout << oneWord << " not found in dictionary . . .\n"
+                        << "   near match(es): ";
+                        suggLabPrinted = true;
                     }
-                    altWord = oneWord;
+                    cout << altWords[i] << "  ";
                 }
             }
             if(suggLabPrinted)
@@ -90,6 +156,15 @@ int main()
             else
                 cout << oneWord << " not found in dictionary . . .\n"
                 << "   no near match(es) to suggest :-( \n";
+            suggester.suggest(oneWord, NUM_SUGGESTIONS, suggestions);
+            if( ! suggestions.empty() )
+            {
+                cout << "   suggestion(s):  ";
+                for(size_t i = 0; i < suggestions.size(); ++i)
+                    cout << suggestions[i].word << " ("
+                    << suggestions[i].distance << ")  ";
+                cout << endl;
+            }
         }
         cout << "\nMore word to spell check? (y/n): ";
         cin >> response;
@@ -102,6 +177,128 @@ int main()
     return EXIT_SUCCESS;
 }
 
+// spell checks each of the numFiles text files fileNames (streamed
+// through spell_check_stream on all hardware threads) against the big
+// dictionary, writing the misspelled words to cout and the totals and
+// throughput of each file to cerr; returns EXIT_FAILURE if the
+// dictionary or a file can't be opened
+int CheckFiles(int numFiles, char* fileNames[])
+{
+    // (wyhash with fibonacci reduction is the fastest policy searching
+    // dict1.txt, see HashBench; the Bloom filter is turned off as most
+    // words of real text are in the dictionary, where it only costs)
+    HashTable hTab(HashTable::INIT_CAP, WY_HASH, FIBONACCI);
+    if ( ! LoadDictionary(hTab, "dict1.txt") )
+    {
+        cerr << "Failed to open dictionary file dict1.txt..." << endl;
+        return EXIT_FAILURE;
+    }
+    hTab.set_filter(false);
+    int status = EXIT_SUCCESS;
+    for (int f = 0; f < numFiles; ++f)
+    {
+        ifstream fin(fileNames[f], ios::in | ios::binary);
+        if ( fin.fail() )
+        {
+            cerr << "Failed to open text file " << fileNames[f] << endl;
+            status = EXIT_FAILURE;
+            continue;
+        }
+        const char* fileName = fileNames[f];
+        chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+        SpellStreamTotals totals = spell_check_stream(hTab, fin,
+            [fileName](const Misspelling& m)
+            {
+                cout << fileName << ':' << m.line << ':' << m.column << ": "
+                     << m.word << '\n';
+            });
+        chrono::duration<double> took = chrono::steady_clock::now() - beg;
+        cerr << fileName << ": " << totals.bytes << " bytes, " << totals.words
+             << " words, " << totals.misspelled << " misspelled in "
+             << took.count() << " seconds ("
+             << (took.count() > 0 ? totals.bytes / took.count() / 1e6 : 0.0)
+             << " MB/s)" << endl;
+    }
+    cout.flush();
+    return status;
+}
+
+// inserts each word of the dictionary file fileName into hTab (whose
+// insert skips words already in it); returns false if the file can't
+// be opened
+template <class Table>
+bool LoadDictionary(Table& hTab, const char* fileName)
+{
+    ifstream fin(fileName, ios::in);
+    if ( fin.fail() )
+        return false;
+    string oneWord;
+    fin >> ws;
+    while ( ! fin.eof() )
+    {
+        fin >> oneWord;
+        hTab.insert(oneWord);
+        fin >> ws;
+    }
+    fin.close();
+    return true;
+}
+
+// HashTable maps the dictionary file and inserts its words in place
+// (tokenized, hashed and deduplicated on all hardware threads); its
+// Bloom filter is turned on since most words the spell checker looks
+// up (the near matches of a misspelled word) are not in the dictionary
+bool LoadDictionary(HashTable& hTab, const char* fileName)
+{
+    hTab.set_filter(true);
+    return hTab.load_parallel(fileName);
+}
+
+// StripedHashTable maps the dictionary file and inserts its words in
+// place from all hardware threads at once (into independent segments)
+bool LoadDictionary(StripedHashTable& hTab, const char* fileName)
+{ return hTab.load(fileName); }
+
+// HashSnapshot opens the snapshot fileName.snap, which is first built
+// (from a HashTable loaded with fileName) if it's missing or invalid
+bool LoadDictionary(HashSnapshot& hTab, const char* fileName)
+{
+    string snapName = string(fileName) + ".snap";
+    if ( hTab.open(snapName.c_str()) )
+        return true;
+    HashTable builder;
+    if ( ! builder.load(fileName) || ! builder.save(snapName.c_str()) )
+        return false;
+    return hTab.open(snapName.c_str());
+}
+
+// PerfectHashTable opens the perfect hash file fileName.phash, which
+// is first built from fileName if it's missing or invalid (it's
+// normally built offline by PerfectHashBuild)
+bool LoadDictionary(PerfectHashTable& hTab, const char* fileName)
+{
+    string phashName = string(fileName) + ".phash";
+    if ( hTab.open(phashName.c_str()) )
+        return true;
+    if ( ! build_perfect_hash(fileName, phashName.c_str()) )
+        return false;
+    return hTab.open(phashName.c_str());
+}
+
+// found[i] is set to hTab.search(words[i]) for i = 0 .. count-1
+template <class Table>
+void SearchBatch(const Table& hTab, const string_view* words,
+                 size_t count, bool* found)
+{
+    for (size_t i = 0; i < count; ++i)
+        found[i] = hTab.search(string(words[i]));
+}
+
+// HashTable overlaps the lookups of a batch (see search_batch)
+void SearchBatch(const HashTable& hTab, const string_view* words,
+                 size_t count, bool* found)
+{ hTab.search_batch(words, count, found); }
+
 void MakeAllLowerCase(string& word)
 {
     HashTable::size_type i = 0, size = word.size();
@@ -0,0 +1,103 @@
+#include "BloomFilter.h"
+#include <cstring>  // for use of memset
+#include <utility>  // for use of swap
+using namespace std;
+
+// odd multipliers picking a bit of each block word (from Parquet's
+// split block Bloom filter)
+static const uint32_t SALT[8] = { 0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                  0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                  0x9efc4947U, 0x5c6bfb31U };
+
+// constructs an empty filter (no blocks: nothing may be contained)
+BloomFilter::BloomFilter()
+: numBlocks(0), numKeys(0), maxKeys(0) { }
+
+// discards the filter's contents and sizes it for up to maxKeys values
+// (BITS_PER_KEY bits each, rounded up to whole blocks)
+void BloomFilter::reset(size_t maxKeys)
+{
+    numBlocks = (maxKeys * BITS_PER_KEY + 511) / 512;
+    if (numBlocks == 0)
+        numBlocks = 1;
+    blocks.reset(new Block[numBlocks]);
+    memset(blocks.get(), 0, numBlocks * sizeof(Block));
+    numKeys = 0;
+    this->maxKeys = maxKeys;
+}
+
+// discards the filter's blocks (nothing may be contained again)
+void BloomFilter::clear()
+{
+    blocks.reset();
+    numBlocks = numKeys = maxKeys = 0;
+}
+
+// exchanges the contents (and sizes) of the filter and other
+void BloomFilter::swap(BloomFilter& other)
+{
+    blocks.swap(other.blocks);
+    std::swap(numBlocks, other.numBlocks);
+    std::swap(numKeys, other.numKeys);
+    std::swap(maxKeys, other.maxKeys);
+}
+
+// returns the block of hash value h: h's high and low 32 bits folded
+// together (hash values such as djb2's of short words have no high
+// bits to speak of) and mixed by a multiplication, whose top bits pick
+// the block, so that the block doesn't simply follow the low bits
+// masks_of picks the block's bits with
+size_t BloomFilter::block_of(uint64_t h) const
+{
+    uint64_t mixed = (h >> 32 ^ h) * 0x9E3779B97F4A7C15ULL;
+    return size_t((unsigned __int128)mixed * numBlocks >> 64);
+}
+
+// masks[i] is set to the bit of block word i that stands for h
+void BloomFilter::masks_of(uint64_t h, uint64_t* masks)
+{
+    uint32_t key = uint32_t(h) ^ uint32_t(h >> 29);
+    for (int i = 0; i < 8; ++i)
+        masks[i] = uint64_t(1) << ((key * SALT[i]) >> 26);
+}
+
+// adds hash value h to the filter (which must have been reset)
+// (counted, even if it was added before: the filter can't tell)
+void BloomFilter::add(uint64_t h)
+{
+    ++numKeys;
+    uint64_t masks[8];
+    masks_of(h, masks);
+    Block& block = blocks[block_of(h)];
+    for (int i = 0; i < 8; ++i)
+        block.words[i] |= masks[i];
+}
+
+// returns false if hash value h was surely never added, true if it
+// may have been (always true if the filter was never reset)
+bool BloomFilter::may_contain(uint64_t h) const
+{
+    if (numBlocks == 0)
+        return true;
+    uint64_t masks[8];
+    masks_of(h, masks);
+    const Block& block = blocks[block_of(h)];
+    uint64_t missing = 0;
+    for (int i = 0; i < 8; ++i)
+        missing |= masks[i] & ~block.words[i];
+    return missing == 0;
+}
+
+// returns true if the filter was never reset (sized)
+bool BloomFilter::empty() const
+{ return numBlocks == 0; }
+
+// returns true if more values have been added since the last reset
+// than the filter was sized for (so that its false positive rate is
+// higher than BITS_PER_KEY gives, and climbs as more are added)
+bool BloomFilter::overfull() const
+{ return numKeys > maxKeys; }
+
+// returns the # of bytes of the filter's blocks
+size_t BloomFilter::bytes() const
+{ return numBlocks * sizeof(Block); }
@@ -0,0 +1,44 @@
+#ifndef BLOOM_FILTER
+#define BLOOM_FILTER
+
+#include <cstdlib>  // for use of size_t
+#include <cstdint>  // for use of uint32_t, uint64_t
+#include <memory>   // for use of unique_ptr
+
+// blocked ("split block") Bloom filter over 64-bit hash values: each
+// value is mapped to one 64-byte block (one cache line) and sets one
+// bit in each of the block's 8 64-bit words, so adding or testing a
+// value touches a single cache line; a test can say that a value was
+// never added (no false negatives), or that it may have been (with a
+// false positive rate of about 1% at the default BITS_PER_KEY)
+class BloomFilter
+{
+public:
+    static const size_t BITS_PER_KEY = 12;
+    BloomFilter();
+    void reset(size_t maxKeys);
+    void clear();
+    void swap(BloomFilter& other);
+    void add(uint64_t h);
+    bool may_contain(uint64_t h) const;
+    bool empty() const;
+    bool overfull() const;
+    size_t bytes() const;
+private:
+    struct alignas(64) Block
+    {
+        uint64_t words[8];
+    };
+    std::unique_ptr<Block[]> blocks;
+    size_t numBlocks;
+    size_t numKeys;     // # of values added since the last reset
+    size_t maxKeys;     // # of values the filter was sized for
+    size_t block_of(uint64_t h) const;
+    static void masks_of(uint64_t h, uint64_t* masks);
+
+    // disable copy construction & copy assignment
+    BloomFilter(const BloomFilter& src);
+    void operator=(const BloomFilter& rhs);
+};
+
+#endif
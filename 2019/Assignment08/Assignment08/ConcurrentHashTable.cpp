@@ -0,0 +1,199 @@
+#include "ConcurrentHashTable.h"
+#include "HashTable.h"  // for use of djb2, is_prime, next_prime
+#include <cstring>      // for use of memcpy, memcmp
+#include <new>          // for use of placement new
+#include <thread>       // for use of this_thread::yield
+using namespace std;
+
+// bytes of Key records allocated at a time
+static const size_t KEY_CHUNK = 64 * 1024;
+
+// returns the reader counter slot of the calling thread (threads are
+// numbered as they first search; the numbers wrap around, which only
+// means a few threads share a counter)
+static size_t reader_slot()
+{
+    static atomic<size_t> nextThread(0);
+    thread_local size_t mine = nextThread.fetch_add(1, memory_order_relaxed);
+    return mine;
+}
+
+// allocates a slot array of the given capacity with all slots vacant
+ConcurrentHashTable::Table* ConcurrentHashTable::new_table(size_type capacity)
+{
+    Table* table = new Table;
+    table->capacity = capacity;
+    table->slots = new atomic<const Key*>[capacity];
+    for (size_type i = 0; i < capacity; ++i)
+        table->slots[i].store(0, memory_order_relaxed);
+    return table;
+}
+
+// returns a slot array (but not the keys it points to) to heap
+void ConcurrentHashTable::delete_table(Table* table)
+{
+    delete [] table->slots;
+    delete table;
+}
+
+// returns the key equal to sWord (whose djb2 hash is h) found in table
+// by quadratic probing, or 0 if there's none
+const ConcurrentHashTable::Key*
+ConcurrentHashTable::find(const Table* table, string_view sWord, size_type h)
+{
+    size_type home = h % table->capacity;
+    size_type index = home;
+    for (size_type numLoops = 1; numLoops <= table->capacity; ++numLoops)
+    {
+        const Key* key = table->slots[index].load(memory_order_acquire);
+        if (key == 0) // Vacant slot ends the probe sequence
+            return 0;
+        if (key->hash == h && key->length == sWord.length()
+            && memcmp(key->chars(), sWord.data(), sWord.length()) == 0)
+            return key;
+        index = (home + numLoops * numLoops) % table->capacity;
+    }
+    return 0;
+}
+
+// constructs an empty table (capacity adjusted as for HashTable)
+ConcurrentHashTable::ConcurrentHashTable(size_type initial_capacity)
+: used(0), epoch(0), chunkNext(0), chunkLeft(0)
+{
+    if (initial_capacity < 11)
+        initial_capacity = next_prime(INIT_CAP);
+    else if ( ! is_prime(initial_capacity))
+        initial_capacity = next_prime(initial_capacity);
+    current.store(new_table(initial_capacity));
+    capacity.store(initial_capacity);
+    for (size_type i = 0; i < READER_SLOTS; ++i)
+        readers[i].active[0] = readers[i].active[1] = 0;
+}
+
+// returns the slot array and all keys to heap
+// (no thread may be using the table any more)
+ConcurrentHashTable::~ConcurrentHashTable()
+{
+    delete_table(current.load());
+    for (size_type i = 0; i < keyChunks.size(); ++i)
+        delete [] keyChunks[i];
+}
+
+// returns the table's current capacity
+ConcurrentHashTable::size_type ConcurrentHashTable::cap() const
+{ return capacity.load(memory_order_relaxed); }
+
+// returns the # of words in the table
+ConcurrentHashTable::size_type ConcurrentHashTable::size() const
+{ return used.load(memory_order_relaxed); }
+
+// returns load-factor calculated as a fraction
+double ConcurrentHashTable::load_factor() const
+{ return double(size()) / cap(); }
+
+// returns true if sWord can be found in the table; safe to call from
+// any number of threads at any time and never waits for a lock
+// (the search is counted as active in the current epoch while it
+// reads the slot array, which keeps a rehash from freeing that array)
+bool ConcurrentHashTable::search(string_view sWord) const
+{
+    size_type h = djb2(sWord);
+    atomic<long>* active = readers[reader_slot() % READER_SLOTS].active;
+    unsigned long e = epoch.load();
+    active[e & 1].fetch_add(1);
+    bool found = find(current.load(), sWord, h) != 0;
+    active[e & 1].fetch_sub(1, memory_order_release);
+    return found;
+}
+
+// inserts sWord (copied into storage owned by the table) if it's not
+// already in the table; returns true if it was inserted
+// (if the insertion results in the load-factor exceeding 0.45,
+// rehash is called to bring down the load-factor)
+bool ConcurrentHashTable::insert(string_view sWord)
+{
+    lock_guard<mutex> guard(writeLock);
+    Table* table = current.load(memory_order_relaxed);
+    size_type h = djb2(sWord);
+    if (find(table, sWord, h) != 0)
+        return false;
+    size_type home = h % table->capacity;
+    size_type index = home;
+    for (size_type numLoops = 1;
+         table->slots[index].load(memory_order_relaxed) != 0; ++numLoops)
+        index = (home + numLoops * numLoops) % table->capacity;
+    // the key is complete before readers can see it (release)
+    table->slots[index].store(new_key(sWord, h), memory_order_release);
+    used.fetch_add(1, memory_order_relaxed);
+    if (double(used.load(memory_order_relaxed)) / table->capacity > .45)
+        rehash();
+    return true;
+}
+
+// returns a new key record holding a copy of sWord (hash h), carved
+// out of the current key chunk (a new chunk is started when needed)
+// (called with writeLock held)
+const ConcurrentHashTable::Key*
+ConcurrentHashTable::new_key(string_view sWord, size_type h)
+{
+    size_type bytes = sizeof(Key) + sWord.length();
+    bytes = (bytes + alignof(Key) - 1) / alignof(Key) * alignof(Key);
+    if (bytes > chunkLeft)
+    {
+        chunkLeft = bytes > KEY_CHUNK ? bytes : KEY_CHUNK;
+        chunkNext = new char[chunkLeft];
+        keyChunks.push_back(chunkNext);
+    }
+    char* at = chunkNext;
+    chunkNext += bytes;
+    chunkLeft -= bytes;
+    Key* key = new (at) Key;
+    key->hash = h;
+    key->length = sWord.length();
+    memcpy(at + sizeof(Key), sWord.data(), sWord.length());
+    return key;
+}
+
+// a slot array whose capacity is the prime number closest to and
+// greater than 2 times the old capacity is filled with the keys of the
+// old one and published; the old array is freed once no search can
+// still be reading it
+// (called with writeLock held)
+void ConcurrentHashTable::rehash()
+{
+    Table* oldTable = current.load(memory_order_relaxed);
+    Table* newTable = new_table(next_prime(oldTable->capacity * 2));
+    for (size_type i = 0; i < oldTable->capacity; ++i)
+    {
+        const Key* key = oldTable->slots[i].load(memory_order_relaxed);
+        if (key == 0)
+            continue;
+        size_type home = key->hash % newTable->capacity;
+        size_type index = home;
+        for (size_type numLoops = 1;
+             newTable->slots[index].load(memory_order_relaxed) != 0; ++numLoops)
+            index = (home + numLoops * numLoops) % newTable->capacity;
+        newTable->slots[index].store(key, memory_order_relaxed);
+    }
+    current.store(newTable); // the new array is complete before it's seen
+    capacity.store(newTable->capacity, memory_order_relaxed);
+    wait_for_readers();
+    delete_table(oldTable);
+}
+
+// waits until every search that started before the call has finished:
+// the epoch is advanced twice, each time waiting for the searches
+// counted under the parity being left to drain (searches counted
+// under the new parity either began after the call or are waited for
+// by the other round)
+// (called with writeLock held)
+void ConcurrentHashTable::wait_for_readers()
+{
+    for (int round = 0; round < 2; ++round)
+    {
+        unsigned long oldEpoch = epoch.fetch_add(1);
+        for (size_type i = 0; i < READER_SLOTS; ++i)
+            while (readers[i].active[oldEpoch & 1].load() != 0)
+                this_thread::yield();
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef CONCURRENT_HASH_TABLE
+#define CONCURRENT_HASH_TABLE
+
+#include <cstdlib>     // for use of size_t
+#include <atomic>      // for use of atomic
+#include <mutex>       // for use of mutex
+#include <string_view> // for use of string_view
+#include <vector>      // for use of vector
+
+// hash table (djb2 hashing and quadratic probing, like HashTable) that
+// any number of threads may search while other threads insert into it
+//   - search never blocks: it reads the current slot array through an
+//     atomic pointer and each slot through an atomic key pointer
+//   - insert (and the rehash it may trigger) is serialized by a mutex;
+//     a rehash publishes the new slot array and then waits for a grace
+//     period (every search that might still be reading the old array
+//     has finished) before freeing the old array (RCU style)
+//   - keys are never moved or freed while the table exists, so a slot,
+//     once filled, stays valid in every slot array it is copied to
+class ConcurrentHashTable
+{
+public:
+    typedef size_t size_type;
+    static const size_type INIT_CAP = 101;
+    // default | 1-argument constructor
+    ConcurrentHashTable(size_type initial_capacity = INIT_CAP);
+    ~ConcurrentHashTable();
+    size_type cap() const;
+    size_type size() const;
+    double load_factor() const;
+    bool search(std::string_view sWord) const;
+    bool insert(std::string_view sWord);
+private:
+    // a word and its (un-reduced) djb2 hash; the chars follow the
+    // record in memory
+    struct Key
+    {
+        size_type hash;
+        size_type length;
+        const char* chars() const
+        { return reinterpret_cast<const char*>(this + 1); }
+    };
+    struct Table
+    {
+        size_type capacity;
+        std::atomic<const Key*>* slots; // 0 for a vacant slot
+    };
+    // searches in progress, counted per epoch parity; spread over
+    // cache-line sized counters so readers rarely share a line
+    static const size_type READER_SLOTS = 64;
+    struct alignas(64) ReaderCount
+    {
+        std::atomic<long> active[2];
+    };
+    std::atomic<Table*> current;
+    std::atomic<size_type> capacity; // current.load()->capacity
+    std::atomic<size_type> used;
+    std::atomic<unsigned long> epoch;
+    mutable ReaderCount readers[READER_SLOTS];
+    std::mutex writeLock;         // held by insert
+    std::vector<char*> keyChunks; // storage for Key records
+    char* chunkNext;              // next free byte of keyChunks.back()
+    size_type chunkLeft;          // # of free bytes from chunkNext on
+    static Table* new_table(size_type capacity);
+    static void delete_table(Table* table);
+    static const Key* find(const Table* table, std::string_view sWord,
+                           size_type h);
+    const Key* new_key(std::string_view sWord, size_type h);
+    void rehash();
+    void wait_for_readers();
+
+    // disable copy construction & copy assignment
+    ConcurrentHashTable(const ConcurrentHashTable& src);
+    void operator=(const ConcurrentHashTable& rhs);
+};
+
+#endif
@@ -0,0 +1,101 @@
+// FILE: ConcurrentStress.cpp
+// Test driver of ConcurrentHashTable's searches during inserts (and
+// the rehashes they trigger)
+// (kept separate from the Assign08 target since it has its own main;
+// build with e.g.
+//   g++ -std=c++17 -O1 -g -pthread -fsanitize=thread ConcurrentStress.cpp ConcurrentHashTable.cpp HashTable.cpp BloomFilter.cpp MappedFile.cpp TextScan.cpp
+// (or -fsanitize=address) and run it as
+//   ConcurrentStress [words] [readers]
+// words (default 200000) being the # of words inserted and readers
+// (default 4) the # of searching threads).
+// Two writer threads insert their halves of the words into a table of
+// the default (small) capacity, so that it is rehashed many times,
+// each publishing how many of its words are in after each insert;
+// meanwhile the reader threads search for words already published
+// (which must be found, in whichever slot array the search reads) and
+// for words never inserted (which must not be). It reports the number
+// of searches made and of wrong answers, and exits with EXIT_FAILURE
+// if there were any.
+#include "ConcurrentHashTable.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+using namespace std;
+
+// returns the i-th word written by writer w ("<w>:<i>"); words that
+// are never inserted use w = 2
+static string WordOf(unsigned w, size_t i)
+{
+    return to_string(w) + ':' + to_string(i);
+}
+
+int main(int argc, char* argv[])
+{
+    const unsigned NUM_WRITERS = 2;
+    size_t numWords = argc > 1 ? size_t(atof(argv[1])) : size_t(200000);
+    unsigned numReaders = argc > 2 ? unsigned(atoi(argv[2])) : 4;
+    size_t perWriter = numWords / NUM_WRITERS;
+
+    ConcurrentHashTable table;
+    atomic<size_t> published[NUM_WRITERS]; // words of each writer in
+    for (unsigned w = 0; w < NUM_WRITERS; ++w)
+        published[w] = 0;
+    atomic<bool> done(false);
+    atomic<uint64_t> searches(0), wrong(0);
+
+    vector<thread> threads;
+    for (unsigned w = 0; w < NUM_WRITERS; ++w)
+        threads.push_back(thread([&, w]()
+        {
+            for (size_t i = 0; i < perWriter; ++i)
+            {
+                if ( ! table.insert(WordOf(w, i)) )
+                    ++wrong; // (each word is inserted once)
+                published[w].store(i + 1, memory_order_release);
+            }
+        }));
+    for (unsigned r = 0; r < numReaders; ++r)
+        threads.push_back(thread([&, r]()
+        {
+            uint64_t state = 88172645463325252ULL + r; // xorshift
+            uint64_t mySearches = 0, myWrong = 0;
+            while ( ! done.load(memory_order_acquire) )
+            {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                unsigned w = unsigned(state % NUM_WRITERS);
+                size_t in = published[w].load(memory_order_acquire);
+                if (in > 0 && ! table.search(WordOf(w, size_t(state >> 8) % in)))
+                    ++myWrong;
+                if (table.search(WordOf(NUM_WRITERS, size_t(state >> 8) % perWriter)))
+                    ++myWrong;
+                mySearches += 2;
+            }
+            searches += mySearches;
+            wrong += myWrong;
+        }));
+    for (unsigned w = 0; w < NUM_WRITERS; ++w)
+        threads[w].join();
+    done.store(true, memory_order_release);
+    for (size_t t = NUM_WRITERS; t < threads.size(); ++t)
+        threads[t].join();
+
+    // every word is in the final table, too
+    for (unsigned w = 0; w < NUM_WRITERS; ++w)
+        for (size_t i = 0; i < perWriter; ++i)
+            if ( ! table.search(WordOf(w, i)) )
+                ++wrong;
+    if (table.size() != perWriter * NUM_WRITERS)
+        ++wrong;
+
+    cout << "words inserted:  " << table.size() << endl;
+    cout << "final capacity:  " << table.cap() << endl;
+    cout << "searches:        " << searches.load() << endl;
+    cout << "wrong answers:   " << wrong.load() << endl;
+    return wrong.load() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,299 @@
+#include "CuckooHashTable.h"
+#include "ScatPlot.h"
+#include <cstring>  // for use of memcpy
+using namespace std;
+
+// words are stored in chunks of (at least) this size
+static const size_t ARENA_CHUNK = 64 * 1024;
+
+// hints the processor to start loading the cache line at addr
+static inline void prefetch(const void* addr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr);
+#endif
+}
+
+// constructs an empty table of (at least) initial_capacity slots: the
+// smallest power of 2 # of buckets (>= 4) that holds that many
+CuckooHashTable::CuckooHashTable(size_type initial_capacity, HashKind hash_kind)
+: numBuckets(4), used(0), numRehashes(0), hashKind(hash_kind),
+  arenaNext(0), arenaLeft(0)
+{
+    while (numBuckets * BUCKET_SLOTS < initial_capacity)
+        numBuckets *= 2;
+    buckets = new Bucket[numBuckets](); // Slots start out vacant
+}
+
+// returns dynamic memory used by the table to heap
+CuckooHashTable::~CuckooHashTable() { delete [] buckets; }
+
+// returns the table's current capacity (# of slots)
+CuckooHashTable::size_type CuckooHashTable::cap() const
+{ return numBuckets * BUCKET_SLOTS; }
+
+// returns the # of words currently in the table
+CuckooHashTable::size_type CuckooHashTable::size() const
+{ return used; }
+
+// returns load-factor calculated as a fraction
+double CuckooHashTable::load_factor() const
+{ return double(used) / cap(); }
+
+// returns the # of times the table was grown (an insert found no path
+// to a vacant slot)
+CuckooHashTable::size_type CuckooHashTable::rehashes() const
+{ return numRehashes; }
+
+// returns the tag of a word whose hash value is h: its high 32 bits,
+// made non-zero (0 marks a vacant slot)
+uint32_t CuckooHashTable::tag_of(uint64_t h)
+{
+    uint32_t tag = uint32_t(h >> 32);
+    return tag != 0 ? tag : 1;
+}
+
+// returns the other bucket of a word with the given tag that can be in
+// bucket (each of a word's 2 buckets is the other one's other bucket)
+CuckooHashTable::size_type
+CuckooHashTable::other_bucket(size_type bucket, uint32_t tag) const
+{
+    uint64_t x = tag * 0xC6A4A7935BD1E995ULL;
+    return (bucket ^ size_type(x ^ (x >> 32))) & (numBuckets - 1);
+}
+
+// returns true if sWord already exists in the table
+// (found by hashing, in its 2 buckets only, like search)
+bool CuckooHashTable::exists(string_view sWord) const
+{
+    size_type bucket, slot;
+    return find(sWord, hash_word(hashKind, sWord), bucket, slot);
+}
+
+// returns true if sWord (whose hash value is h) is in the table, with
+// bucket and slot set to where it is (bucket set to numBuckets and
+// slot to its index in stash, if it is stashed); only its 2 buckets
+// are looked at (both prefetched first, so that their cache misses
+// overlap), and the stash if there's anything in it
+bool CuckooHashTable::find(string_view sWord, uint64_t h,
+                           size_type& bucket, size_type& slot) const
+{
+    uint32_t tag = tag_of(h);
+    size_type first = size_type(h) & (numBuckets - 1);
+    size_type second = other_bucket(first, tag);
+    prefetch(&buckets[second]);
+    size_type candidates[2] = { first, second };
+    for (int c = 0; c < 2; ++c)
+    {
+        const Bucket& b = buckets[candidates[c]];
+        for (size_type s = 0; s < BUCKET_SLOTS; ++s)
+        {
+            if (b.slots[s].tag == tag
+                && string_view(b.slots[s].chars, b.slots[s].length) == sWord)
+            {
+                bucket = candidates[c];
+                slot = s;
+                return true;
+            }
+        }
+    }
+    for (size_type i = 0; i < stash.size(); ++i)
+    {
+        if (stash[i].tag == tag
+            && string_view(stash[i].chars, stash[i].length) == sWord)
+        {
+            bucket = numBuckets;
+            slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// returns true if sWord can be found in the table
+bool CuckooHashTable::search(string_view sWord) const
+{
+    size_type bucket, slot;
+    return find(sWord, hash_word(hashKind, sWord), bucket, slot);
+}
+
+// item (a word not in the table yet) is put in a vacant slot of bucket
+// or of its other bucket, if any; otherwise a breadth-first search
+// starting from those 2 buckets looks for the shortest path of words
+// that each move to their other bucket, the last one into a vacant
+// slot, and the words along it are moved last first, freeing a slot
+// for item; returns false (table unchanged) if there's no such path
+// among the first MAX_PATH_BUCKETS buckets reached
+bool CuckooHashTable::place(const Slot& item, size_type bucket)
+{
+    // a bucket reached by the search, and how: the word in slot
+    // fromSlot of the bucket of node parent would move into it
+    struct Node
+    {
+        size_type bucket;
+        int parent;     // index of the parent node (-1 for the 2 roots)
+        int fromSlot;   // slot of the parent's bucket moving here
+    };
+    Node roots[2] = { { bucket, -1, -1 },
+                      { other_bucket(bucket, item.tag), -1, -1 } };
+    vector<Node> nodes(roots, roots + (roots[1].bucket != bucket ? 2 : 1));
+    for (size_type head = 0; head < nodes.size(); ++head)
+    {
+        Bucket& b = buckets[nodes[head].bucket];
+        size_type vacant = BUCKET_SLOTS;
+        for (size_type s = 0; s < BUCKET_SLOTS && vacant == BUCKET_SLOTS; ++s)
+            if (b.slots[s].tag == 0)
+                vacant = s;
+        if (vacant != BUCKET_SLOTS) // Moving the words along the path
+        {
+            int n = int(head);
+            while (nodes[n].parent >= 0)
+            {
+                const Node& node = nodes[n];
+                Slot& from = buckets[nodes[node.parent].bucket].slots[node.fromSlot];
+                buckets[node.bucket].slots[vacant] = from;
+                from.tag = 0;
+                vacant = size_type(node.fromSlot);
+                n = node.parent;
+            }
+            buckets[nodes[n].bucket].slots[vacant] = item;
+            ++used;
+            return true;
+        }
+        for (size_type s = 0; s < BUCKET_SLOTS; ++s)
+        {
+            if (nodes.size() >= MAX_PATH_BUCKETS)
+                break;
+            size_type next = other_bucket(nodes[head].bucket, b.slots[s].tag);
+            bool onPath = false; // (a path must not visit a bucket twice)
+            for (int n = int(head); n >= 0 && ! onPath; n = nodes[n].parent)
+                onPath = nodes[n].bucket == next;
+            if ( ! onPath )
+                nodes.push_back(Node{ next, int(head), int(s) });
+        }
+    }
+    return false;
+}
+
+// item (a word not in the table yet) is placed into its buckets, or
+// stashed if place finds no room for it
+void CuckooHashTable::place_or_stash(const Slot& item)
+{
+    uint64_t h = hash_word(hashKind, string_view(item.chars, item.length));
+    if ( ! place(item, size_type(h) & (numBuckets - 1)) )
+    {
+        stash.push_back(item);
+        ++used;
+    }
+}
+
+// if sWord is not in the table yet, it is copied into the arena and
+// inserted into the table and true is returned, otherwise false is
+// returned (if no path to a vacant slot is found, the table is grown
+// by rehash once, if it is at least MIN_GROW_PCT percent full, and
+// the word stashed should it still find no place)
+// (an empty word is not inserted)
+bool CuckooHashTable::insert(string_view sWord)
+{
+    if (sWord.empty())
+        return false;
+    uint64_t h = hash_word(hashKind, sWord);
+    size_type bucket, slot;
+    if ( find(sWord, h, bucket, slot) )
+        return false;
+    Slot item = { store(sWord), uint32_t(sWord.length()), tag_of(h) };
+    if ( place(item, size_type(h) & (numBuckets - 1)) )
+        return true;
+    if (used * 100 >= cap() * MIN_GROW_PCT) // Full enough to grow
+    {
+        rehash();
+        place_or_stash(item);
+    }
+    else
+    {
+        stash.push_back(item);
+        ++used;
+    }
+    return true;
+}
+
+// removes sWord from the table if it's there (returning true, false
+// otherwise) by vacating its slot
+bool CuckooHashTable::erase(string_view sWord)
+{
+    size_type bucket, slot;
+    if ( ! find(sWord, hash_word(hashKind, sWord), bucket, slot) )
+        return false;
+    if (bucket == numBuckets) // Stashed: the last one takes its place
+    {
+        stash[slot] = stash.back();
+        stash.pop_back();
+    }
+    else
+        buckets[bucket].slots[slot].tag = 0;
+    --used;
+    return true;
+}
+
+// a table with twice the buckets replaces the old one and every word
+// (stashed ones too) is re-placed into it, or stashed should it find
+// no place (never growing the table again); the words are hashed
+// again, since slots only keep their tags, and their chars stay where
+// they are in the arena
+void CuckooHashTable::rehash()
+{
+    Bucket* newBuckets = new Bucket[numBuckets * 2](); // (may throw)
+    Bucket* oldBuckets = buckets;
+    size_type oldNumBuckets = numBuckets;
+    vector<Slot> oldStash;
+    oldStash.swap(stash);
+    buckets = newBuckets;
+    numBuckets *= 2;
+    used = 0;
+    for (size_type b = 0; b < oldNumBuckets; ++b)
+        for (size_type s = 0; s < BUCKET_SLOTS; ++s)
+            if (oldBuckets[b].slots[s].tag != 0)
+                place_or_stash(oldBuckets[b].slots[s]);
+    for (size_type i = 0; i < oldStash.size(); ++i)
+        place_or_stash(oldStash[i]);
+    delete [] oldBuckets;
+    ++numRehashes;
+}
+
+// copies sWord into the arena and returns where its chars now are
+// (a new chunk is started when the current one is too full)
+const char* CuckooHashTable::store(string_view sWord)
+{
+    if (sWord.length() > arenaLeft)
+    {
+        arenaLeft = sWord.length() > ARENA_CHUNK ? sWord.length() : ARENA_CHUNK;
+        arena.push_back(unique_ptr<char[]>(new char[arenaLeft]));
+        arenaNext = arena.back().get();
+    }
+    char* at = arenaNext;
+    memcpy(at, sWord.data(), sWord.length());
+    arenaNext += sWord.length();
+    arenaLeft -= sWord.length();
+    return at;
+}
+
+// graphs a horizontal histogram that gives a decent idea of how
+// items are distributed over the table
+void CuckooHashTable::scat_plot(ostream& out) const
+{
+    plot_slots(out, cap(), [this](size_type i)
+               { return buckets[i / BUCKET_SLOTS].slots[i % BUCKET_SLOTS].tag != 0; });
+}
+
+// dumping to out contents of "segment of slots" of the table
+void CuckooHashTable::grading_helper_print(ostream& out) const
+{
+    out << endl << "Content of selected hash table segment:\n";
+    for (size_type i = 10; i < 30 && i < cap(); ++i)
+    {
+        const Slot& slot = buckets[i / BUCKET_SLOTS].slots[i % BUCKET_SLOTS];
+        out << '[' << i << "]: "
+            << (slot.tag != 0 ? string_view(slot.chars, slot.length) : string_view())
+            << endl;
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef CUCKOO_HASH_TABLE
+#define CUCKOO_HASH_TABLE
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint32_t, uint64_t
+#include <iostream>    // for use of ostream
+#include <memory>      // for use of unique_ptr
+#include <string_view> // for use of string_view
+#include <vector>      // for use of vector
+#include "HashFunctions.h"
+
+// bucketized cuckoo hash table: the slots are grouped into buckets of
+// BUCKET_SLOTS slots that fill one 64-byte cache line each, and a word
+// can only be in one of 2 buckets, both computed from its hash value
+// (the 2nd from the 1st and the word's tag, the high 32 bits of its
+// hash value, so that a word can be moved to its other bucket without
+// hashing it again); thus
+//   - a search reads at most 2 cache lines of the table (both are
+//     prefetched together) and compares the chars of a word only if
+//     its tag matches, whatever the load factor or clustering
+//   - an insert into 2 full buckets frees a slot by moving words to
+//     their other buckets along the shortest such path, found by a
+//     breadth-first search over at most MAX_PATH_BUCKETS buckets; only
+//     if there is none is the table grown (rehash), which lets it fill
+//     95% or more of its slots before it grows
+//   - a word that finds no place while the table is less than
+//     MIN_GROW_PCT percent full (or right after it grew) goes into a
+//     stash that searches look through as well, if it isn't empty;
+//     growing wouldn't help such a word, which shares its buckets with
+//     too many others (words whose hash values are all the same, say),
+//     and it must not grow the table again and again
+//   - erase just vacates the word's slot (no tombstones are needed)
+// (words are copied into an arena owned by the table)
+// (same public interface as HashTable so the two are interchangeable)
+class CuckooHashTable
+{
+public:
+    typedef size_t size_type;
+    static const size_type INIT_CAP = 128;
+    static const size_type BUCKET_SLOTS = 4;
+    static const size_type MAX_PATH_BUCKETS = 512;
+    static const size_type MIN_GROW_PCT = 50;
+    // default | 1-argument | 2-argument constructor
+    CuckooHashTable(size_type initial_capacity = INIT_CAP,
+                    HashKind hash_kind = WY_HASH);
+    ~CuckooHashTable();
+    size_type cap() const;
+    size_type size() const;
+    bool exists(std::string_view sWord) const;
+    bool search(std::string_view sWord) const;
+    double load_factor() const;
+    size_type rehashes() const;
+    void scat_plot(std::ostream& out) const;
+    void grading_helper_print(std::ostream& out) const;
+    bool insert(std::string_view sWord);
+    bool erase(std::string_view sWord);
+private:
+    struct Slot
+    {
+        const char* chars;  // word's chars (in the arena)
+        uint32_t length;    // # of chars of the word
+        uint32_t tag;       // high bits of the word's hash (0 if vacant)
+    };
+    struct alignas(64) Bucket
+    {
+        Slot slots[BUCKET_SLOTS];
+    };
+    Bucket* buckets;
+    size_type numBuckets; // # of buckets (power of 2)
+    std::vector<Slot> stash; // words that found no place in buckets
+    size_type used;       // # of words in the table
+    size_type numRehashes; // # of times the table was grown
+    HashKind hashKind;    // hash function policy
+    // chars of words are bump-allocated out of chunks
+    std::vector<std::unique_ptr<char[]>> arena;
+    char* arenaNext;      // next free byte of arena.back()
+    size_type arenaLeft;  // # of free bytes from arenaNext on
+    static uint32_t tag_of(uint64_t h);
+    size_type other_bucket(size_type bucket, uint32_t tag) const;
+    bool find(std::string_view sWord, uint64_t h,
+              size_type& bucket, size_type& slot) const;
+    bool place(const Slot& item, size_type bucket);
+    void place_or_stash(const Slot& item);
+    void rehash();
+    const char* store(std::string_view sWord);
+
+    // disable copy construction & copy assignment
+    CuckooHashTable(const CuckooHashTable& src);
+    void operator=(const CuckooHashTable& rhs);
+};
+
+#endif
@@ -0,0 +1,198 @@
+#include "GroupHashTable.h"
+#include "ScatPlot.h"
+#include <cstring>  // for use of memset
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// the table is grown once more than 7/8 of its slots are in use
+static const double MAX_LOAD = 0.875;
+
+// returns a bit mask whose bit i is set when the control tag of slot
+// (group * GROUP_WIDTH + i) equals tag
+unsigned GroupHashTable::match_group(size_type group, unsigned char tag) const
+{
+    const unsigned char* g = ctrl + group * GROUP_WIDTH;
+#ifdef __SSE2__
+    __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g));
+    __m128i want = _mm_set1_epi8(char(tag));
+    return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, want)));
+#else
+    unsigned mask = 0;
+    for (size_type i = 0; i < GROUP_WIDTH; ++i)
+        if (g[i] == tag) mask |= 1u << i;
+    return mask;
+#endif
+}
+
+// returns the index of the lowest set bit of a non-zero mask
+static inline unsigned lowest_bit(unsigned mask)
+{
+    unsigned i = 0;
+    while ( ! (mask & 1u) ) { mask >>= 1; ++i; }
+    return i;
+}
+
+// returns the full (un-reduced) hash of word: djb2 followed by a
+// multiplicative mix so that both the low 7 bits (used as the tag)
+// and the high bits (used to pick the home group) are well spread
+GroupHashTable::size_type GroupHashTable::hash(const string& word) const
+{
+    unsigned long long h = 5381;
+    for (size_type i = 0; i < word.length(); ++i)
+        h = ((h << 5) + h) + (unsigned char)word[i]; // h*33 + c
+    h *= 0x9E3779B97F4A7C15ULL;
+    return size_type(h ^ (h >> 32));
+}
+
+// returns the index of the first vacant slot along the group probe
+// sequence of hash value h (the table always has a vacant slot)
+GroupHashTable::size_type GroupHashTable::find_vacant(size_type h) const
+{
+    size_type numGroups = capacity / GROUP_WIDTH;
+    size_type group = (h >> 7) & (numGroups - 1);
+    unsigned mask;
+    for (size_type step = 1; (mask = match_group(group, EMPTY)) == 0; ++step)
+        group = (group + step) & (numGroups - 1);
+    return group * GROUP_WIDTH + lowest_bit(mask);
+}
+
+// a new table twice the size replaces the old one and every word is
+// moved (not copied) into it
+void GroupHashTable::rehash()
+{
+    unsigned char* oldCtrl = ctrl;
+    Item* oldData = data;
+    size_type oldCap = capacity;
+    capacity *= 2;
+    used = 0;
+    ctrl = new unsigned char[capacity];
+    memset(ctrl, EMPTY, capacity);
+    data = new Item[capacity];
+    for (size_type i = 0; i < oldCap; ++i)
+    {
+        if (oldCtrl[i] != EMPTY)
+        {
+            size_type h = hash(oldData[i].word);
+            size_type index = find_vacant(h);
+            ctrl[index] = (unsigned char)(h & 0x7F);
+            data[index].word = std::move(oldData[i].word);
+            ++used;
+        }
+    }
+    delete [] oldCtrl;
+    delete [] oldData;
+}
+
+// returns true if sWord already exists in the table, otherwise false
+// (found by hashing, along sWord's group probe sequence, like search)
+bool GroupHashTable::exists(const string& sWord) const
+{
+    return search(sWord);
+}
+
+// returns true if sWord can be found in the table; groups are visited
+// in triangular order (which covers every group of a power-of-2 table)
+// and the search stops at the first group that still has a vacant slot
+bool GroupHashTable::search(const string& sWord) const
+{
+    size_type h = hash(sWord);
+    unsigned char tag = (unsigned char)(h & 0x7F);
+    size_type numGroups = capacity / GROUP_WIDTH;
+    size_type group = (h >> 7) & (numGroups - 1);
+    for (size_type step = 1; step <= numGroups; ++step)
+    {
+        unsigned mask = match_group(group, tag);
+        while (mask != 0) // only slots whose tag matches are compared
+        {
+            unsigned bit = lowest_bit(mask);
+            if (data[group * GROUP_WIDTH + bit].word == sWord)
+                return true;
+            mask &= mask - 1;
+        }
+        if (match_group(group, EMPTY) != 0)
+            return false;
+        group = (group + step) & (numGroups - 1);
+    }
+    return false;
+}
+
+// returns load-factor calculated as a fraction
+double GroupHashTable::load_factor() const
+{ return double(used) / capacity; }
+
+// constructs an empty table whose capacity is the smallest power of 2
+// (and multiple of GROUP_WIDTH) that is >= initial_capacity
+GroupHashTable::GroupHashTable(size_type initial_capacity)
+: capacity(GROUP_WIDTH), used(0)
+{
+    while (capacity < initial_capacity)
+        capacity *= 2;
+    ctrl = new unsigned char[capacity];
+    memset(ctrl, EMPTY, capacity);
+    data = new Item[capacity];
+}
+
+// returns dynamic memory used by the table to heap
+GroupHashTable::~GroupHashTable()
+{
+    delete [] ctrl;
+    delete [] data;
+}
+
+// returns the table's current capacity
+GroupHashTable::size_type GroupHashTable::cap() const
+{ return capacity; }
+
+// returns the # of slots currently in use (non-vacant)
+GroupHashTable::size_type GroupHashTable::size() const
+{ return used; }
+
+// graphs a horizontal histogram that gives a decent idea of how
+// items are distributed over the table
+void GroupHashTable::scat_plot(ostream& out) const
+{
+    plot_slots(out, capacity, [this](size_type i) { return ctrl[i] != EMPTY; });
+}
+
+// dumping to out contents of "segment of slots" of the table
+void GroupHashTable::grading_helper_print(ostream& out) const
+{
+    out << endl << "Content of selected hash table segment:\n";
+    for (size_type i = 10; i < 30 && i < capacity; ++i)
+        out << '[' << i << "]: " << data[i].word << endl;
+}
+
+// if sWord is not in the table yet, it is placed in the first vacant
+// slot along its group probe sequence and tagged with its hash
+// fragment, and true is returned; otherwise false is returned
+// (a search ends at the first group with a vacant slot, which is
+// where the vacant slot is taken from, so one walk does both)
+// (if the insertion results in the load-factor exceeding MAX_LOAD,
+// rehash is called to double the capacity)
+bool GroupHashTable::insert(const string& sWord)
+{
+    size_type h = hash(sWord);
+    unsigned char tag = (unsigned char)(h & 0x7F);
+    size_type numGroups = capacity / GROUP_WIDTH;
+    size_type group = (h >> 7) & (numGroups - 1);
+    unsigned vacant;
+    for (size_type step = 1; ; ++step)
+    {
+        unsigned mask = match_group(group, tag);
+        for ( ; mask != 0; mask &= mask - 1)
+            if (data[group * GROUP_WIDTH + lowest_bit(mask)].word == sWord)
+                return false;
+        if ((vacant = match_group(group, EMPTY)) != 0)
+            break;
+        group = (group + step) & (numGroups - 1);
+    }
+    size_type index = group * GROUP_WIDTH + lowest_bit(vacant);
+    ctrl[index] = tag;
+    data[index].word = sWord;
+    ++used;
+    if (load_factor() > MAX_LOAD)
+        rehash();
+    return true;
+}
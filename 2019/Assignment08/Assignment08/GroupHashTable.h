@@ -0,0 +1,51 @@
+#ifndef GROUP_HASH_TABLE
+#define GROUP_HASH_TABLE
+
+#include <cstdlib>  // for use of size_t
+#include <iostream> // for use of ostream
+#include <string>   // for use of string
+
+// open-addressing hash table that keeps a parallel array of 1-byte
+// control tags next to the word slots; a tag is either EMPTY or the
+// low 7 bits of the word's hash (a "fragment"), so a probe can test a
+// whole group of GROUP_WIDTH tags at once (SSE2 when available) and
+// only compares the actual strings of slots whose fragment matches
+// (same public interface as HashTable so the two are interchangeable)
+class GroupHashTable
+{
+public:
+    typedef size_t size_type;
+    static const size_type GROUP_WIDTH = 16;
+    static const size_type INIT_CAP = 128;
+    // default | 1-argument constructor
+    GroupHashTable(size_type initial_capacity = INIT_CAP);
+    ~GroupHashTable();
+    size_type cap() const;
+    size_type size() const;
+    bool exists(const std::string& sWord) const;
+    bool search(const std::string& sWord) const;
+    double load_factor() const;
+    void scat_plot(std::ostream& out) const;
+    void grading_helper_print(std::ostream& out) const;
+    bool insert(const std::string& sWord);
+private:
+    static const unsigned char EMPTY = 0x80; // vacant slot tag
+    struct Item
+    {
+        std::string word;  // word as string
+    };
+    unsigned char* ctrl; // control tags, one per slot
+    Item* data;
+    size_type capacity;  // # of slots (power of 2, multiple of GROUP_WIDTH)
+    size_type used;      // # of slots in use (non-vacant)
+    size_type hash(const std::string& word) const;
+    unsigned match_group(size_type group, unsigned char tag) const;
+    size_type find_vacant(size_type h) const;
+    void rehash();
+
+    // disable copy construction & copy assignment
+    GroupHashTable(const GroupHashTable& src) = delete;
+    void operator=(const GroupHashTable& rhs) = delete;
+};
+
+#endif
@@ -0,0 +1,283 @@
+// FILE: HashBench.cpp
+// Benchmark of the hash function policies (HashFunctions.h) and slot
+// reductions of HashTable over the dictionaries dict0.txt and dict1.txt
+// (kept separate from the Assign08 target since it has its own main;
+// build with e.g.
+//   g++ -std=c++17 -O2 -pthread HashBench.cpp HashTable.cpp BloomFilter.cpp StripedHashTable.cpp MappedFile.cpp TextScan.cpp
+// and run it where the dictionary files are).
+// For each dictionary and each policy it reports
+//   - ns/hash:   time to hash one word
+//   - ns/search: time to search one word (all words, in file order)
+//   - probes:    mean / max # of probe steps of successful searches and
+//                how many words are found after 0, 1, 2, 3 and 4+ steps
+//   - row cv:    coefficient of variation of the # of slots in use per
+//                scatter plot row (0 = perfectly even, higher = clustered)
+// and then, for the default policy with and without the Bloom filter
+// in front of HashTable (HashTable::set_filter), over words that are
+// not in the dictionary (each dictionary word with a '#' appended)
+//   - fp rate:   fraction of those words the filter lets through
+//   - ns/miss:   time to search one of them, unfiltered and filtered
+//   - ns/hit:    time to search one dictionary word, likewise
+// along with the mean probe lengths of those searches (unfiltered), and
+// the rehashes and memory of the table, from HashTable::stats, and
+// finally the time to count the occurrences of the words (as
+// string_views, the way text is scanned) in a HashMap<string, int>
+// and in a std::unordered_map<string, int> (which needs a string
+// made of each word to look it up), and the rate at which 1, 2, 4, 8
+// and 16 threads insert the words (and those with a '#' appended)
+// into one StripedHashTable, each thread an equal share, and the time
+// to search one word of the table, for % prime and for fibonacci slot
+// reduction (the segment of a word must not be picked with bits the
+// reduction uses, or the words of a segment would crowd into a few of
+// its slots)
+#include "HashTable.h"
+#include "MappedFile.h"
+#include "TextScan.h"
+#include "BloomFilter.h"
+#include "HashMap.h"
+#include "StripedHashTable.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <thread>
+using namespace std;
+
+// returns the average time (in ns) hashing one of words takes with
+// the hash function policy Hash
+template <class Hash>
+double NsPerHash(const vector<string_view>& words)
+{
+    const int ROUNDS = 20;
+    Hash hash;
+    uint64_t sink = 0; // keeps the compiler from dropping the work
+    chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+        for (size_t i = 0; i < words.size(); ++i)
+            sink += hash(words[i]);
+    chrono::duration<double, nano> took = chrono::steady_clock::now() - beg;
+    if (sink == 1) cout << ' ';
+    return took.count() / (double(ROUNDS) * words.size());
+}
+
+// returns the average time (in ns) of HashTable::search over words,
+// all of which are expected to be found if hits is true, none otherwise
+double NsPerSearch(const HashTable& hTab, const vector<string_view>& words,
+                   bool hits = true)
+{
+    size_t found = 0;
+    chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+    for (size_t i = 0; i < words.size(); ++i)
+        found += hTab.search(words[i]);
+    chrono::duration<double, nano> took = chrono::steady_clock::now() - beg;
+    if (found != (hits ? words.size() : 0)) cout << "(wrong results!) ";
+    return took.count() / words.size();
+}
+
+// returns the mean probe length of a HashTableStats probe histogram
+double MeanProbes(const uint64_t* probes)
+{
+    double total = 0, steps = 0;
+    for (size_t k = 0; k < HashTableStats::PROBE_BUCKETS; ++k)
+    {
+        total += probes[k];
+        steps += double(k) * probes[k];
+    }
+    return total > 0 ? steps / total : 0.0;
+}
+
+// writes the results of the Bloom filter in front of a default policy
+// HashTable loaded with the dictionary fileName; the false positive
+// rate is that of a filter sized and filled the way HashTable does it
+void FilterReport(const char* fileName, const vector<string_view>& words)
+{
+    vector<string> missChars(words.size());
+    vector<string_view> misses(words.size());
+    for (size_t i = 0; i < words.size(); ++i)
+    {
+        missChars[i] = string(words[i]) + '#';
+        misses[i] = missChars[i];
+    }
+    HashTable hTab;
+    hTab.load(fileName);
+    BloomFilter filter;
+    filter.reset(size_t(hTab.cap() * .45) + 1);
+    for (size_t i = 0; i < words.size(); ++i)
+        filter.add(hash_word(DJB2_HASH, words[i]));
+    size_t passed = 0;
+    for (size_t i = 0; i < misses.size(); ++i)
+        passed += filter.may_contain(hash_word(DJB2_HASH, misses[i]));
+
+    NsPerSearch(hTab, misses, false); // warm up
+    double nsMiss = NsPerSearch(hTab, misses, false),
+           nsHit = NsPerSearch(hTab, words);
+    HashTableStats st;
+    hTab.stats(st);
+    hTab.set_filter(true);
+    double nsMissFiltered = NsPerSearch(hTab, misses, false),
+           nsHitFiltered = NsPerSearch(hTab, words);
+    cout << "bloom filter (djb2 % prime, " << hTab.filter_bytes() / 1024
+         << " KB for " << hTab.cap() << " slots)" << endl << fixed
+         << "  fp rate: " << setprecision(4) << double(passed) / misses.size()
+         << setprecision(1)
+         << "  ns/miss: " << nsMiss << " -> " << nsMissFiltered
+         << " (" << setprecision(2) << nsMiss / nsMissFiltered << "x)"
+         << setprecision(1)
+         << "  ns/hit: " << nsHit << " -> " << nsHitFiltered << endl;
+    cout << "  unfiltered: mean probes " << setprecision(3)
+         << MeanProbes(st.hit_probes) << " per hit, "
+         << MeanProbes(st.miss_probes) << " per miss; " << st.rehashes
+         << " rehashes in " << setprecision(1) << st.rehash_seconds * 1e3
+         << " ms; " << st.bytes_allocated / 1024 << " KB allocated" << endl;
+}
+
+// writes one line of results for a HashTable using policy kind and
+// reduction loaded with the dictionary fileName
+void Report(const char* label, double nsHash, HashKind kind,
+            Reduction reduction, const char* fileName,
+            const vector<string_view>& words)
+{
+    HashTable hTab(HashTable::INIT_CAP, kind, reduction);
+    hTab.load(fileName);
+    double nsSearch = NsPerSearch(hTab, words);
+
+    HashTableStats st;
+    hTab.stats(st);
+    vector<HashTable::size_type> counts;
+    hTab.probe_histogram(counts);
+    size_t bucket[5] = { 0, 0, 0, 0, 0 };
+    for (size_t k = 0; k < counts.size(); ++k)
+        bucket[k < 4 ? k : 4] += counts[k];
+
+    cout << setw(22) << left << label << right << fixed
+         << setw(8) << setprecision(2) << nsHash
+         << setw(10) << setprecision(1) << nsSearch
+         << setw(7) << setprecision(3) << st.mean_displacement
+         << setw(5) << st.max_displacement << "  ";
+    for (int b = 0; b < 5; ++b)
+        cout << setw(7) << bucket[b];
+    cout << setw(8) << setprecision(3) << st.row_cv << endl;
+}
+
+// returns the average time (in ns) of counting one of words in a
+// word -> count map of type Map, using count(map, word)
+template <class Map, class Count>
+double NsPerCount(const vector<string_view>& words, Count count)
+{
+    const int ROUNDS = 20;
+    Map counts;
+    chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+        for (size_t i = 0; i < words.size(); ++i)
+            count(counts, words[i]);
+    chrono::duration<double, nano> took = chrono::steady_clock::now() - beg;
+    if (counts.size() == 0) cout << ' ';
+    return took.count() / (double(ROUNDS) * words.size());
+}
+
+// returns the # of millions of words per second numThreads threads
+// insert into a StripedHashTable using reduction, each inserting every
+// numThreads-th of words and then of misses (so 2x words.size() words
+// in all); nsSearch is set to the average time (in ns) of searching
+// one of words in the table afterwards
+double MWordsPerSecond(const vector<string_view>& words,
+                       const vector<string_view>& misses, unsigned numThreads,
+                       Reduction reduction, double& nsSearch)
+{
+    StripedHashTable hTab(StripedHashTable::INIT_CAP, DJB2_HASH, reduction);
+    chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t)
+        threads.push_back(thread([&, t]
+        {
+            for (size_t i = t; i < words.size(); i += numThreads)
+                hTab.insert(words[i]);
+            for (size_t i = t; i < misses.size(); i += numThreads)
+                hTab.insert(misses[i]);
+        }));
+    for (unsigned t = 0; t < numThreads; ++t)
+        threads[t].join();
+    chrono::duration<double> took = chrono::steady_clock::now() - beg;
+
+    size_t found = 0;
+    chrono::steady_clock::time_point searchBeg = chrono::steady_clock::now();
+    for (size_t i = 0; i < words.size(); ++i)
+        found += hTab.search(words[i]);
+    chrono::duration<double, nano> searchTook = chrono::steady_clock::now() - searchBeg;
+    if (found != words.size()) cout << "(wrong results!) ";
+    nsSearch = searchTook.count() / words.size();
+    return 2.0 * words.size() / took.count() / 1e6;
+}
+
+int main()
+{
+    const char* fileNames[] = { "dict0.txt", "dict1.txt" };
+    for (int f = 0; f < 2; ++f)
+    {
+        MappedFile file;
+        if ( ! file.open(fileNames[f]) )
+        {
+            cerr << "Failed to open dictionary file " << fileNames[f]
+                 << " (skipped)" << endl;
+            continue;
+        }
+        vector<string_view> words;
+        const char* p = skip_space(file.begin(), file.end());
+        while (p < file.end())
+        {
+            const char* wordEnd = skip_word(p, file.end());
+            words.push_back(string_view(p, size_t(wordEnd - p)));
+            p = skip_space(wordEnd, file.end());
+        }
+        cout << endl << fileNames[f] << " (" << words.size() << " words)"
+             << endl << setw(22) << left << "policy" << right
+             << setw(8) << "ns/hash" << setw(10) << "ns/search"
+             << setw(7) << "probes" << setw(5) << "max" << "  "
+             << setw(7) << "0" << setw(7) << "1" << setw(7) << "2"
+             << setw(7) << "3" << setw(7) << "4+" << setw(8) << "row cv"
+             << endl;
+        NsPerHash<Djb2Hash>(words); // warm up caches (and clock speed)
+        double nsDjb2 = NsPerHash<Djb2Hash>(words),
+               nsWy = NsPerHash<WyHash>(words),
+               nsXxh3 = NsPerHash<Xxh3Hash>(words);
+        Report("djb2 % prime", nsDjb2, DJB2_HASH, PRIME_MOD, fileNames[f], words);
+        Report("djb2 fibonacci", nsDjb2, DJB2_HASH, FIBONACCI, fileNames[f], words);
+        Report("wyhash % prime", nsWy, WY_HASH, PRIME_MOD, fileNames[f], words);
+        Report("wyhash fibonacci", nsWy, WY_HASH, FIBONACCI, fileNames[f], words);
+        Report("xxh3 % prime", nsXxh3, XXH3_HASH, PRIME_MOD, fileNames[f], words);
+        Report("xxh3 fibonacci", nsXxh3, XXH3_HASH, FIBONACCI, fileNames[f], words);
+        FilterReport(fileNames[f], words);
+        double nsMap = NsPerCount<HashMap<string, int>>(words,
+                           [](HashMap<string, int>& m, string_view w) { ++m[w]; });
+        double nsStd = NsPerCount<unordered_map<string, int>>(words,
+                           [](unordered_map<string, int>& m, string_view w) { ++m[string(w)]; });
+        cout << "word counts: HashMap " << setprecision(1) << nsMap
+             << " ns/word, unordered_map " << nsStd << " ns/word" << endl;
+        vector<string> missChars(words.size());
+        vector<string_view> misses(words.size());
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            missChars[i] = string(words[i]) + '#';
+            misses[i] = missChars[i];
+        }
+        cout << "striped inserts (Mwords/s by # of threads; "
+             << thread::hardware_concurrency() << " hardware threads)"
+             << " and ns/search" << endl;
+        const char* labels[] = { "djb2 % prime", "djb2 fibonacci" };
+        Reduction reductions[] = { PRIME_MOD, FIBONACCI };
+        for (int r = 0; r < 2; ++r)
+        {
+            double nsSearch = 0;
+            cout << "  " << setw(16) << left << labels[r] << right;
+            for (unsigned numThreads = 1; numThreads <= 16; numThreads *= 2)
+                cout << "  " << numThreads << ": " << setprecision(1)
+                     << MWordsPerSecond(words, misses, numThreads,
+                                        reductions[r], nsSearch);
+            cout << "  search: " << nsSearch << " ns" << endl;
+        }
+    }
+    return EXIT_SUCCESS;
+}
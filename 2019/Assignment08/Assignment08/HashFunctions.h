@@ -0,0 +1,182 @@
+#ifndef HASH_FUNCTIONS
+#define HASH_FUNCTIONS
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint32_t, uint64_t
+#include <cstring>     // for use of memcpy
+#include <string_view> // for use of string_view
+
+// HASH POLICIES
+//   function objects that map a word to an (un-reduced) 64-bit hash
+//   value; each also names the SEED it starts from (recorded in hash
+//   table snapshots so that a reader can tell how a file was hashed)
+//   - Djb2Hash: the classic byte-at-a-time djb2 (hash*33 + c)
+//   - WyHash:   wyhash-style, 8 (and 16) bytes per step folded with a
+//               64x64->128 bit multiply
+//   - Xxh3Hash: xxHash3-style, 8 bytes per step with rotate/multiply
+//               rounds and the XXH3 avalanche at the end
+//   (WyHash and Xxh3Hash follow the structure of the originals but
+//   are not bit-compatible with their reference implementations)
+
+const unsigned long DJB2_SEED = 5381;
+
+// returns the (un-reduced) djb2 hash of word
+// (2nd page of Lecture Note 324s02AdditionalNotesOnHashFunctions)
+inline unsigned long djb2(std::string_view word)
+{
+    // All this code is directly from the notes + Q&A section
+    unsigned long hash = DJB2_SEED; int c;
+
+    for(size_t i = 0; i < word.length(); i++ )
+    {
+        c = word[i];
+        hash = ((hash << 5) + hash) + c; // hash*33 + c
+    }
+    return hash;
+}
+
+struct Djb2Hash
+{
+    static const uint64_t SEED = DJB2_SEED;
+    uint64_t operator()(std::string_view word) const
+    { return djb2(word); }
+};
+
+// helpers for the multi-byte-at-a-time policies (unaligned reads in
+// the machine's byte order, and the 128-bit multiply fold)
+inline uint64_t read64(const char* p)
+{ uint64_t v; memcpy(&v, p, 8); return v; }
+
+inline uint64_t read32(const char* p)
+{ uint32_t v; memcpy(&v, p, 4); return v; }
+
+inline uint64_t mum_fold(uint64_t a, uint64_t b)
+{
+    unsigned __int128 r = (unsigned __int128)a * b;
+    return uint64_t(r) ^ uint64_t(r >> 64);
+}
+
+struct WyHash
+{
+    static const uint64_t SEED = 0xa0761d6478bd642fULL;
+    uint64_t operator()(std::string_view word) const
+    {
+        const uint64_t P1 = 0xe7037ed1a0b428dbULL, P2 = 0x8ebc6af09c88c6e3ULL;
+        const char* p = word.data();
+        size_t len = word.length();
+        uint64_t seed = SEED, a, b;
+        if (len <= 16)
+        {
+            if (len >= 4) // two overlapping 4-byte reads from each end
+            {
+                size_t mid = (len >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + mid);
+                b = (read32(p + len - 4) << 32) | read32(p + len - 4 - mid);
+            }
+            else if (len > 0)
+            {
+                a = (uint64_t((unsigned char)p[0]) << 16)
+                    | (uint64_t((unsigned char)p[len >> 1]) << 8)
+                    | uint64_t((unsigned char)p[len - 1]);
+                b = 0;
+            }
+            else
+                a = b = 0;
+        }
+        else
+        {
+            size_t i = len;
+            for ( ; i > 16; i -= 16, p += 16)
+                seed = mum_fold(read64(p) ^ P1, read64(p + 8) ^ seed);
+            a = read64(p + i - 16); // last 16 bytes (may overlap)
+            b = read64(p + i - 8);
+        }
+        return mum_fold(P1 ^ len, mum_fold(a ^ P1, b ^ seed ^ P2));
+    }
+};
+
+struct Xxh3Hash
+{
+    static const uint64_t SEED = 0x9E3779B185EBCA87ULL; // XXH PRIME64_1
+    uint64_t operator()(std::string_view word) const
+    {
+        const uint64_t P2 = 0xC2B2AE3D27D4EB4FULL, P4 = 0x85EBCA77C2B2AE63ULL;
+        const char* p = word.data();
+        size_t len = word.length();
+        uint64_t acc = SEED * (len + 1);
+        for ( ; len >= 8; len -= 8, p += 8)
+        {
+            acc ^= mum_fold(read64(p) ^ P2, P4);
+            acc = ((acc << 27) | (acc >> 37)) * SEED + P4;
+        }
+        if (len > 0) // 1..7 trailing bytes
+        {
+            uint64_t tail;
+            if (len >= 4) // two (overlapping) 4-byte reads
+                tail = (read32(p) << 32) | read32(p + len - 4);
+            else
+                tail = (uint64_t((unsigned char)p[0]) << 16)
+                       | (uint64_t((unsigned char)p[len >> 1]) << 8)
+                       | uint64_t((unsigned char)p[len - 1]);
+            acc ^= mum_fold(tail ^ P4, P2 ^ len);
+        }
+        acc ^= acc >> 37; // XXH3 avalanche
+        acc *= 0x165667919E3779F9ULL;
+        return acc ^ (acc >> 32);
+    }
+};
+
+// selects one of the policies above at run time
+enum HashKind { DJB2_HASH, WY_HASH, XXH3_HASH };
+
+// returns the hash of word computed by the policy named by kind
+inline uint64_t hash_word(HashKind kind, std::string_view word)
+{
+    switch (kind)
+    {
+        case WY_HASH:   return WyHash()(word);
+        case XXH3_HASH: return Xxh3Hash()(word);
+        default:        return Djb2Hash()(word);
+    }
+}
+
+// returns the SEED of the policy named by kind
+inline uint64_t hash_seed(HashKind kind)
+{
+    switch (kind)
+    {
+        case WY_HASH:   return WyHash::SEED;
+        case XXH3_HASH: return Xxh3Hash::SEED;
+        default:        return Djb2Hash::SEED;
+    }
+}
+
+// SLOT REDUCTION
+//   how a hash value is turned into a slot index of a table
+//   - PRIME_MOD: prime capacity, home slot hash % capacity, quadratic
+//                probing (home + i*i) % capacity
+//   - FIBONACCI: power-of-2 capacity, home slot taken from the high
+//                bits of hash * 2^64/phi (multiply-shift, no division),
+//                triangular probing (home + i*(i+1)/2) & (capacity-1),
+//                which visits every slot of a power-of-2 table
+enum Reduction { PRIME_MOD, FIBONACCI };
+
+// returns the home slot of hash value h in a table of the given capacity
+inline size_t home_slot(uint64_t h, size_t capacity, Reduction reduction)
+{
+    if (reduction == PRIME_MOD)
+        return size_t(h % capacity);
+    return size_t((h * 0x9E3779B97F4A7C15ULL) >> (64 - __builtin_ctzll(capacity)));
+}
+
+// returns the slot visited on the numLoops-th step of the probe
+// sequence that starts at home
+inline size_t probe_slot(size_t home, size_t numLoops, size_t capacity,
+                         Reduction reduction)
+{
+    if (reduction == PRIME_MOD)
+        return (home + numLoops * numLoops) % capacity;
+    return (home + numLoops * (numLoops + 1) / 2) & (capacity - 1);
+}
+
+#endif
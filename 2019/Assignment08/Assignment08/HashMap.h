@@ -0,0 +1,125 @@
+#ifndef HASH_MAP
+#define HASH_MAP
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint64_t
+#include <string>      // for use of string
+#include <string_view> // for use of string_view
+#include <functional>  // for use of hash, equal_to
+#include <utility>     // for use of pair, move, forward, swap
+#include <tuple>       // for use of forward_as_tuple
+#include <new>         // for use of launder, placement new
+#include "HashFunctions.h"
+
+// default hash function policy of HashMap: std::hash of the key, except
+// for string keys, which are hashed by WyHash as string_views so that
+// a HashMap<std::string, V> can be searched with a string_view (or a
+// C string) without building a std::string first
+template <class K>
+struct MapHash
+{
+    uint64_t operator()(const K& key) const { return std::hash<K>()(key); }
+};
+
+template <>
+struct MapHash<std::string>
+{
+    typedef void is_transparent;
+    uint64_t operator()(std::string_view key) const { return WyHash()(key); }
+};
+
+template <>
+struct MapHash<std::string_view>
+{
+    typedef void is_transparent;
+    uint64_t operator()(std::string_view key) const { return WyHash()(key); }
+};
+
+// HashMap<K, V, Hash, Eq>: the open-addressing scheme of HashTable for
+// any key and value types: quadratic (triangular) probing of a power of
+// 2 # of slots reduced to by FIBONACCI hashing, each slot keeping the
+// hash value of its key (compared before the keys themselves, and
+// reused by rehash), and tombstones for erased keys that are compacted
+// away once they take up MAX_TOMB_PCT percent of the slots
+// - keys are looked up by any type Q that Hash and Eq accept along with
+//   K (heterogeneous lookup), e.g. string_view for string keys; Hash
+//   must give equal hash values for a Q and a K that are equal
+// - try_emplace constructs the value (and the key, from the Q given)
+//   in its slot, and only if the key isn't there yet; emplace builds
+//   the (key, value) pair first, then moves it into its slot
+// - rehash moves the entries into the new slots (copying only types
+//   whose move constructor may throw) and never hashes a key again
+// - pointers to values are valid until the next insertion or erase
+// - the map can be moved, not copied (like HashTable)
+template <class K, class V, class Hash = MapHash<K>, class Eq = std::equal_to<>>
+class HashMap
+{
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    typedef size_t size_type;
+    static const size_type INIT_CAP = 16;
+    static const size_type MAX_LOAD_PCT = 70; // growth threshold
+    static const size_type MAX_TOMB_PCT = 20; // compaction threshold
+    // default | 1-argument | 2-argument | 3-argument constructor
+    HashMap(size_type initial_capacity = INIT_CAP, const Hash& hash = Hash(),
+            const Eq& eq = Eq());
+    HashMap(HashMap&& src) noexcept;
+    HashMap& operator=(HashMap&& rhs) noexcept;
+    ~HashMap();
+    size_type cap() const;
+    size_type size() const;
+    bool empty() const;
+    double load_factor() const;
+    template <class Q> V* find(const Q& key);
+    template <class Q> const V* find(const Q& key) const;
+    template <class Q> bool contains(const Q& key) const;
+    template <class Q, class... Args>
+    std::pair<V*, bool> try_emplace(Q&& key, Args&&... args);
+    template <class... Args>
+    std::pair<V*, bool> emplace(Args&&... args);
+    template <class Q> V& operator[](Q&& key);
+    template <class Q> bool erase(const Q& key);
+    void reserve(size_type numKeys);
+    void clear();
+    template <class Fn> void for_each(Fn fn);
+    template <class Fn> void for_each(Fn fn) const;
+    void swap(HashMap& other) noexcept;
+private:
+    enum State : unsigned char { VACANT = 0, IN_USE, DELETED };
+    // a slot's entry lives in raw storage, constructed only while the
+    // slot is in use (so vacant slots are zero-filled plain data)
+    struct Slot
+    {
+        uint64_t hash;      // hash value of the key (if in use)
+        State state;
+        alignas(value_type) unsigned char storage[sizeof(value_type)];
+        value_type& entry()
+        { return *std::launder(reinterpret_cast<value_type*>(storage)); }
+        const value_type& entry() const
+        { return *std::launder(reinterpret_cast<const value_type*>(storage)); }
+    };
+    Slot* slots;
+    size_type capacity; // # of slots (a power of 2)
+    size_type used;     // # of entries
+    size_type tombs;    // # of tombstones
+    Hash hasher;
+    Eq equal;
+    template <class Q> uint64_t hash_of(const Q& key) const;
+    template <class Q> size_type locate(const Q& key, uint64_t h) const;
+    template <class Q> bool probe_insert(const Q& key, uint64_t h,
+                                         size_type& index) const;
+    size_type probe_vacant(uint64_t h) const;
+    size_type make_room(uint64_t h, size_type index);
+    void rehash(size_type newCapacity);
+    void destroy_entries();
+
+    // disable copy construction & copy assignment
+    HashMap(const HashMap& src);
+    void operator=(const HashMap& rhs);
+};
+
+#include "HashMap.template"
+
+#endif
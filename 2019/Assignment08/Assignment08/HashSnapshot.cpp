@@ -0,0 +1,129 @@
+#include "HashSnapshot.h"
+#include "ScatPlot.h"
+#include <cstring>      // for use of memcmp, memcpy
+using namespace std;
+
+// constructs a snapshot with nothing opened (0 capacity)
+HashSnapshot::HashSnapshot()
+: slots(0), arena(0), capacity(0), used(0),
+  hashKind(DJB2_HASH), reduction(PRIME_MOD) { }
+
+// maps the snapshot file at path and checks that its header, slot
+// array and arena are consistent with the file's size, and that the
+// word of every slot in use lies within the arena (and that a FIBONACCI
+// snapshot's capacity is a power of 2, as its home slots are the top
+// bits of the mixed hash value); returns false
+// (nothing opened) if the file can't be mapped or isn't a snapshot of
+// the current version (or is truncated or corrupted)
+// (the sizes are compared by dividing, as a corrupted header's counts
+// could make a product or sum overflow and pass the comparison)
+bool HashSnapshot::open(const char* path)
+{
+    slots = 0;
+    arena = 0;
+    capacity = used = 0;
+    if ( ! file.open(path) )
+        return false;
+    SnapshotHeader header;
+    if (file.size() < sizeof(header))
+    {
+        file.close();
+        return false;
+    }
+    memcpy(&header, file.begin(), sizeof(header));
+    uint64_t bodyBytes = file.size() - sizeof(header);
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0
+        || header.version != SNAPSHOT_VERSION
+        || header.slot_bytes != sizeof(SnapshotSlot)
+        || header.hash_kind > XXH3_HASH
+        || header.hash_seed != hash_seed(HashKind(header.hash_kind))
+        || header.reduction > FIBONACCI
+        || header.capacity == 0
+        || (header.reduction == FIBONACCI // (home_slot needs a power of 2 >= 2)
+            && (header.capacity < 2 || (header.capacity & (header.capacity - 1)) != 0))
+        || header.capacity > bodyBytes / sizeof(SnapshotSlot)
+        || header.used >= header.capacity
+        || header.arena_bytes != bodyBytes - header.capacity * sizeof(SnapshotSlot))
+    {
+        file.close();
+        return false;
+    }
+    const SnapshotSlot* fileSlots =
+        reinterpret_cast<const SnapshotSlot*>(file.begin() + sizeof(header));
+    uint64_t inUse = 0;
+    for (uint64_t i = 0; i < header.capacity; ++i)
+    {
+        if (fileSlots[i].length == 0)
+            continue;
+        if (fileSlots[i].offset > header.arena_bytes
+            || fileSlots[i].length > header.arena_bytes - fileSlots[i].offset)
+        {
+            file.close(); // (a word past the end of the arena)
+            return false;
+        }
+        ++inUse;
+    }
+    if (inUse != header.used)
+    {
+        file.close();
+        return false;
+    }
+    slots = fileSlots;
+    arena = file.begin() + sizeof(header) + header.capacity * sizeof(SnapshotSlot);
+    capacity = size_type(header.capacity);
+    used = size_type(header.used);
+    hashKind = HashKind(header.hash_kind);
+    reduction = Reduction(header.reduction);
+    return true;
+}
+
+// returns the word stored in slot i (empty if the slot is vacant)
+string_view HashSnapshot::word_at(size_type i) const
+{ return string_view(arena + slots[i].offset, slots[i].length); }
+
+// returns the snapshot's capacity
+HashSnapshot::size_type HashSnapshot::cap() const
+{ return capacity; }
+
+// returns the # of slots in use (non-vacant)
+HashSnapshot::size_type HashSnapshot::size() const
+{ return used; }
+
+// returns true if sWord can be found in the snapshot, probing exactly
+// as HashTable::search does (from the word's home slot until the word
+// or a vacant slot is met)
+bool HashSnapshot::search(string_view sWord) const
+{
+    if (capacity == 0)
+        return false;
+    size_type home = home_slot(hash_word(hashKind, sWord), capacity, reduction);
+    size_type index = home;
+    for (size_type numLoops = 1; numLoops <= capacity; ++numLoops)
+    {
+        if (slots[index].length == 0)
+            return false;
+        if (word_at(index) == sWord)
+            return true;
+        index = probe_slot(home, numLoops, capacity, reduction);
+    }
+    return false;
+}
+
+// returns load-factor calculated as a fraction
+double HashSnapshot::load_factor() const
+{ return capacity == 0 ? 0.0 : double(used) / capacity; }
+
+// graphs a horizontal histogram that gives a decent idea of how
+// items are distributed over the snapshot
+void HashSnapshot::scat_plot(ostream& out) const
+{
+    plot_slots(out, capacity, [this](size_type i) { return slots[i].length != 0; });
+}
+
+// dumping to out contents of "segment of slots" of the snapshot
+void HashSnapshot::grading_helper_print(ostream& out) const
+{
+    out << endl << "Content of selected hash table segment:\n";
+    for (size_type i = 10; i < 30 && i < capacity; ++i)
+        out << '[' << i << "]: " << word_at(i) << endl;
+}
@@ -0,0 +1,71 @@
+#ifndef HASH_SNAPSHOT
+#define HASH_SNAPSHOT
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint32_t, uint64_t
+#include <iostream>    // for use of ostream
+#include <string_view> // for use of string_view
+#include "MappedFile.h"
+#include "HashFunctions.h"
+
+// ON-DISK LAYOUT of a hash table snapshot (written by HashTable::save):
+//   SnapshotHeader                       (fixed size, 64 bytes)
+//   SnapshotSlot[capacity]               (one per hash table slot)
+//   char[arena_bytes]                    (the words, back to back)
+// Values are stored in the byte order of the machine that wrote the
+// file. The slot array mirrors the hash table's own slot array, so a
+// word is found in the snapshot by the very same hash function and
+// probe sequence used by HashTable::search (recorded in the header).
+const char SNAPSHOT_MAGIC[8] = { 'H', 'T', 'S', 'N', 'A', 'P', '\0', '\0' };
+const uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader
+{
+    char magic[8];        // SNAPSHOT_MAGIC
+    uint32_t version;     // SNAPSHOT_VERSION
+    uint32_t slot_bytes;  // sizeof(SnapshotSlot)
+    uint64_t capacity;    // # of slots
+    uint64_t used;        // # of slots in use (non-vacant)
+    uint64_t hash_seed;   // SEED of the hash function policy
+    uint64_t arena_bytes; // # of bytes of word chars
+    uint32_t hash_kind;   // HashKind of the hash function policy
+    uint32_t reduction;   // Reduction used to map hashes to slots
+    uint64_t reserved;    // 0 (room for later versions)
+};
+
+struct SnapshotSlot
+{
+    uint32_t offset; // where the slot's word starts in the arena
+    uint32_t length; // length of the slot's word (0 if vacant)
+};
+
+// read-only hash table searched directly in a memory mapped snapshot;
+// processes opening the same snapshot share one page-cache copy
+class HashSnapshot
+{
+public:
+    typedef size_t size_type;
+    HashSnapshot();
+    bool open(const char* path);
+    size_type cap() const;
+    size_type size() const;
+    bool search(std::string_view sWord) const;
+    double load_factor() const;
+    void scat_plot(std::ostream& out) const;
+    void grading_helper_print(std::ostream& out) const;
+private:
+    MappedFile file;
+    const SnapshotSlot* slots; // slot array inside the mapping
+    const char* arena;         // string arena inside the mapping
+    size_type capacity;        // # of slots
+    size_type used;            // # of slots in use (non-vacant)
+    HashKind hashKind;         // hash function policy of the file
+    Reduction reduction;       // hash value -> slot mapping of the file
+    std::string_view word_at(size_type i) const;
+
+    // disable copy construction & copy assignment
+    HashSnapshot(const HashSnapshot& src);
+    void operator=(const HashSnapshot& rhs);
+};
+
+#endif
@@ -1,8 +1,67 @@
 #include "HashTable.h"
-#include <iomanip>  // for use of setw
-#include <cmath>
+#include "ScatPlot.h"
+#include "TextScan.h"
+#include "HashSnapshot.h"
+#include <fstream>  // for use of ofstream
+#include <cstring>  // for use of memset, memcpy
+#include <new>      // for use of bad_alloc
+#include <thread>   // for use of thread
+#include <atomic>   // for use of atomic
+#include <chrono>   // for use of steady_clock
+#include <cmath>    // for use of sqrt
+#include <cassert>  // for use of assert
+#include <algorithm> // for use of max
 using namespace std;
 
+// tombstones point at (0 chars at) this address, which no word shares
+const char HashTable::TOMBSTONE[1] = { 0 };
+
+// words added by insert are stored in chunks of (at least) this size
+static const size_t ARENA_CHUNK = 64 * 1024;
+
+// runs work(0) .. work(numThreads - 1) on numThreads threads and
+// waits for all of them to finish
+template <class Work>
+static void run_threads(unsigned numThreads, Work work)
+{
+    vector<thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t)
+        threads.push_back(thread(work, t));
+    for (unsigned t = 0; t < numThreads; ++t)
+        threads[t].join();
+}
+
+// returns h mixed so that all of its bits depend on all bits of h (h
+// may be a djb2 hash, whose high bits are 0 for short words)
+static inline uint64_t mix(uint64_t h)
+{
+    return h * 0x9E3779B97F4A7C15ULL;
+}
+
+// adds 1 to statistics counter c (relaxed: only the count matters)
+static inline void bump(atomic<uint64_t>& c)
+{
+    c.fetch_add(1, memory_order_relaxed);
+}
+
+// returns the statistics stripe of the calling thread (threads are
+// numbered as they first search; the numbers wrap around, which only
+// means a few threads share a stripe)
+static size_t stat_stripe()
+{
+    static atomic<size_t> nextThread(0);
+    thread_local size_t mine = nextThread.fetch_add(1, memory_order_relaxed);
+    return mine;
+}
+
+// hints the processor to start loading the cache line at addr
+static inline void prefetch(const void* addr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr);
+#endif
+}
+
 // a new hash table whose capacity is the prime number closest to
 // and greater that 2 times the capacity of the old hash table
 // replaces the old hash table and all items from the old hash table
@@ -11,137 +70,549 @@ using namespace std;
 // (HINT: put next_prime and insert to good use)
 void HashTable::rehash()
 {
-    Item *tombstone = data;
-    size_type tombCap = capacity;
-    used = 0;
-    capacity = next_prime(capacity * 2); // Increasing capacity via next_prime
-    data = new Item[capacity]; // Reinitializing data
+    rehash(grown_capacity(capacity));
+}
+
+// a new hash table of capacity newCapacity replaces the old one and
+// all words of the old hash table are re-placed into it; tombstones
+// are dropped along the way, so newCapacity == capacity compacts the
+// hash table (only the slots are copied, using the hash value each
+// slot keeps, so no word is hashed again and the chars never move;
+// used is left as is since no word is added or lost)
+// in incremental mode the old hash table is instead kept around and
+// drained a few slots at a time by the updates that follow (see migrate)
+// (counted, and timed, in the statistics)
+void HashTable::rehash(size_type newCapacity)
+{
+    chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+    migrate(oldCapacity); // Finishing any earlier incremental rehash
+    Item *oldTable = data;
+    size_type oldTableCap = capacity;
+    capacity = newCapacity;
+    data = new_slots(capacity); // Reinitializing data
+    tombs = 0;
     
-    for (size_type i = 0; i < tombCap; ++i) // Transferring data
+    if (filtering) // (the new filter is filled as words are placed)
     {
-        if (tombstone[i].word[0] != '\0') // Making sure to not insert nothing
+        if (incremental)
+            filter.swap(oldFilter); // Still covering the old table's words
+        filter.reset(size_type(capacity * .45) + 1);
+    }
+    if (incremental) // Old table is drained later by migrate
+    {
+        oldData = oldTable;
+        oldCapacity = oldTableCap;
+        migrated = 0;
+        count_rehash(beg);
+#ifdef DEBUG
+        assert(verify());
+#endif
+        return;
+    }
+    for (size_type i = 0; i < oldTableCap; ++i) // Transferring data
+    {
+        if ( oldTable[i].in_use() ) // Skipping vacant slots and tombstones
         {
-            insert(tombstone[i].word);
+            data[probe_vacant(oldTable[i].hash)] = oldTable[i];
+            if (filtering)
+                filter.add(oldTable[i].hash);
         }
         
     }
-    delete [] tombstone;
+    free(oldTable);
+    count_rehash(beg);
+#ifdef DEBUG
+    assert(verify());
+#endif
+}
+
+// adds a rehash that began at beg to the statistics
+void HashTable::count_rehash(chrono::steady_clock::time_point beg)
+{
+    chrono::nanoseconds took = chrono::steady_clock::now() - beg;
+    bump(numRehashes);
+    rehashNanos.fetch_add(uint64_t(took.count()), memory_order_relaxed);
+}
+
+// if filtering, the filter is sized for maxKeys words and filled with
+// the hash values of the words in data and of those not moved yet
+// from the table being drained, if any (erased words, which the filter
+// can't forget otherwise, are left out), and the drained table's own
+// filter is released
+// (only when filtering is turned on, or the filter is overfull; rehash
+// and migrate fill the filter as they place words, without a pass of
+// their own)
+void HashTable::rebuild_filter(size_type maxKeys)
+{
+    if ( ! filtering )
+        return;
+    filter.reset(maxKeys);
+    for (size_type i = 0; i < capacity; ++i)
+        if (data[i].in_use())
+            filter.add(data[i].hash);
+    for (size_type i = migrated; i < oldCapacity; ++i) // (the rest are in data)
+        if (oldData[i].in_use())
+            filter.add(oldData[i].hash);
+    oldFilter.clear();
+}
+
+// moves (up to) the next numSlots slots of the table being drained by
+// an incremental rehash into data, discarding the drained table once
+// all of its slots have been moved (nothing happens if there's none)
+// (moved words are left in the drained table so that its probe
+// sequences stay intact for searches until it is discarded; its
+// tombstones are not moved)
+// (if filtering, moved words are added to the filter, and the drained
+// table's filter is released along with the table)
+void HashTable::migrate(size_type numSlots)
+{
+    if (oldData == 0)
+        return;
+    for ( ; numSlots > 0 && migrated < oldCapacity; --numSlots, ++migrated)
+    {
+        if ( ! oldData[migrated].in_use() )
+            continue;
+        size_type index = probe_vacant(oldData[migrated].hash);
+        if ( data[index].deleted() )
+            --tombs;
+        data[index] = oldData[migrated];
+        if (filtering)
+            filter.add(oldData[migrated].hash);
+    }
+    if (migrated == oldCapacity)
+    {
+        oldFilter.clear();
+        free(oldData);
+        oldData = 0;
+        oldCapacity = migrated = 0;
+    }
 }
 
 // returns true if sWord already exists in the hash table,
 // otherwise returns false
-bool HashTable::exists(const string& sWord) const
+// (found by hashing, like search; the full scan of every slot that
+// this used to do is now part of verify)
+bool HashTable::exists(string_view sWord) const
+{
+    return search(sWord);
+}
+
+#ifdef DEBUG
+// returns true if the hash table is consistent: every word found by a
+// full scan of the slots can be found by search (in the slot array
+// where it was seen, if an incremental rehash is in progress) and the
+// # of words and tombstones seen match used and erased()
+// (debug builds only, as it visits every slot; asserted after each
+// load, rehash and erase)
+bool HashTable::verify() const
 {
+    size_type numWords = 0, numTombs = 0, numProbes;
     for (size_type i = 0; i < capacity; ++i)
-        if ( data[i].word == sWord ) return true;
-    return false;
+    {
+        if (data[i].deleted())
+            ++numTombs;
+        else if (data[i].in_use())
+        {
+            ++numWords;
+            if (data[i].hash != hash(data[i].word())
+                || ! search_in(data, capacity, data[i].word(), data[i].hash,
+                               numProbes))
+                return false;
+        }
+    }
+    for (size_type i = 0; i < oldCapacity; ++i) // words not yet moved
+    {
+        if (oldData[i].in_use())
+        {
+            if ( ! search_in(oldData, oldCapacity, oldData[i].word(), oldData[i].hash,
+                            numProbes) )
+                return false;
+            if ( i >= migrated )
+                ++numWords;
+        }
+    }
+    for (size_type i = 0; filtering && i < capacity; ++i) // no false negatives
+        if (data[i].in_use() && ! filter.may_contain(data[i].hash))
+            return false;
+    for (size_type i = migrated; filtering && i < oldCapacity; ++i)
+        if (oldData[i].in_use() && ! filter.may_contain(oldData[i].hash)
+            && (oldFilter.empty() || ! oldFilter.may_contain(oldData[i].hash)))
+            return false;
+    return numWords == used && numTombs == tombs;
 }
+#endif
 
 // returns true if sWord can be found in the hash table
 // (MUST use hashing technique, NOT doing a linear search
 // like what is done in exists above),
 // otherwise return false
 // CAUTION: major penalty if not using hashing technique
-bool HashTable::search(const string& sWord) const
+// (while an incremental rehash is in progress, words not yet found in
+// the new table are looked for in the table being drained as well)
+bool HashTable::search(string_view sWord) const
+{
+    return search_hashed(sWord, hash(sWord));
+}
+
+// returns true if sWord, whose hash value is h, can be found in the
+// hash table (in the table being drained as well, if any)
+// (if filtering, most words not in the hash table are turned away by
+// the filter, at the cost of one cache line, without probing at all;
+// during an incremental rehash, by both the filter and the drained
+// table's filter)
+// (the search is counted in the statistics, by its probe length)
+bool HashTable::search_hashed(string_view sWord, uint64_t h) const
 {
-    size_type toFind = hash(sWord); // Hashing the string I'm looking for
+    SearchCounts& counts = searchCounts[stat_stripe() % STAT_STRIPES];
+    if (filtering && ! filter.may_contain(h)
+        && (oldFilter.empty() || ! oldFilter.may_contain(h)))
+    {
+        bump(counts.filtered);
+        return false;
+    }
+    size_type numProbes = 0, oldProbes = 0;
+    bool found = search_in(data, capacity, sWord, h, numProbes)
+                 || (oldData != 0
+                     && search_in(oldData, oldCapacity, sWord, h, oldProbes));
+    numProbes += oldProbes;
+    if (numProbes >= HashTableStats::PROBE_BUCKETS)
+        numProbes = HashTableStats::PROBE_BUCKETS - 1;
+    bump(found ? counts.hitProbes[numProbes] : counts.missProbes[numProbes]);
+    return found;
+}
+
+// returns true if sWord (whose hash value is h) can be found in the
+// slot array items (of capacity itemCap) by quadratic probing, and
+// sets numProbes to the # of probe steps taken after the home slot
+// (tombstones are probed past, only a vacant slot ends the search;
+// the chars of a slot are only compared if its hash value is h)
+bool HashTable::search_in(const Item* items, size_type itemCap,
+                          string_view sWord, uint64_t h,
+                          size_type& numProbes) const
+{
+    size_type toFind = home_slot(h, itemCap, reduction); // Home slot of the string I'm looking for
     size_type index = toFind; // Creating variables to search the array
     size_type numLoops = 0;
     do
     {
         
-        if (sWord.compare(data[index].word) == 0) // Found sWord
+        if (items[index].vacant()) // Vacant slot ends the probe sequence
+        {
+            numProbes = numLoops;
+            return false;
+        }
+        else if (items[index].hash == h && items[index].in_use()
+                 && sWord.compare(items[index].word()) == 0) // Found sWord
         {
+            numProbes = numLoops;
             return true;
         }
         else // sWord not found; advance variables
         {
             ++numLoops;
-            index = (toFind + (numLoops * numLoops)) % capacity; // Quadratic probing
+            index = probe_slot(toFind, numLoops, itemCap, reduction); // Quadratic probing
         }
     }
-    while(numLoops < capacity);
+    while(numLoops < itemCap);
+    numProbes = numLoops;
     return false; // If it gets through the do-while then sWord not found
 }
 
+// if sWord (whose hash value is h) can be found in the slot array
+// items (of capacity itemCap), its slot is turned into a tombstone and
+// true is returned, otherwise false is returned
+bool HashTable::erase_in(Item* items, size_type itemCap,
+                         string_view sWord, uint64_t h)
+{
+    size_type home = home_slot(h, itemCap, reduction);
+    size_type index = home;
+    for (size_type numLoops = 0; numLoops < itemCap; )
+    {
+        if (items[index].vacant())
+            return false;
+        if (items[index].hash == h && items[index].in_use()
+            && sWord == items[index].word())
+        {
+            items[index].chars = TOMBSTONE;
+            items[index].length = 0;
+            return true;
+        }
+        index = probe_slot(home, ++numLoops, itemCap, reduction);
+    }
+    return false;
+}
+
+// found[i] is set to search(words[i]) for i = 0 .. count-1
+// the words are handled BATCH_SIZE at a time: all home slots of a
+// batch are hashed and prefetched first, then the chars of the words
+// in those slots, and only then are the probes resolved, so that the
+// cache misses of a whole batch overlap instead of being taken one
+// lookup after another
+void HashTable::search_batch(const string_view* words, size_type count,
+                             bool* found) const
+{
+    uint64_t h[BATCH_SIZE];
+    for (size_type beg = 0; beg < count; beg += BATCH_SIZE)
+    {
+        size_type n = count - beg < BATCH_SIZE ? count - beg : BATCH_SIZE;
+        for (size_type i = 0; i < n; ++i)
+        {
+            h[i] = hash(words[beg + i]);
+            prefetch(&data[home_slot(h[i], capacity, reduction)]);
+        }
+        for (size_type i = 0; i < n; ++i)
+            prefetch(data[home_slot(h[i], capacity, reduction)].chars);
+        for (size_type i = 0; i < n; ++i)
+            found[beg + i] = search_hashed(words[beg + i], h[i]);
+    }
+}
+
+// turns incremental rehashing on or off (turning it off completes
+// an incremental rehash that may be in progress)
+void HashTable::set_incremental(bool enable)
+{
+    incremental = enable;
+    if ( ! incremental )
+        migrate(oldCapacity);
+}
+
+// turns the Bloom filter in front of searches on (building it from the
+// words already in the hash table) or off (releasing it)
+void HashTable::set_filter(bool enable)
+{
+    filtering = enable;
+    if (filtering)
+        rebuild_filter(size_type(capacity * .45) + 1);
+    else
+    {
+        filter.clear();
+        oldFilter.clear();
+    }
+}
+
+// returns the # of bytes of the Bloom filter (0 unless filtering), and
+// of the drained table's filter during an incremental rehash
+HashTable::size_type HashTable::filter_bytes() const
+{ return filter.bytes() + oldFilter.bytes(); }
+
+// out is set to the hash table's statistics: the search and rehash
+// counters and figures computed from a scan of the slots (the latter
+// cost time proportional to the capacity)
+void HashTable::stats(HashTableStats& out) const
+{
+    out.hash_kind = hashKind;
+    out.reduction = reduction;
+    out.capacity = capacity;
+    out.used = used;
+    out.tombstones = tombs;
+    out.hits = out.misses = out.filtered = 0;
+    for (size_type k = 0; k < HashTableStats::PROBE_BUCKETS; ++k)
+    {
+        out.hit_probes[k] = out.miss_probes[k] = 0;
+        for (size_type st = 0; st < STAT_STRIPES; ++st) // Adding up the stripes
+        {
+            out.hit_probes[k] += searchCounts[st].hitProbes[k].load(memory_order_relaxed);
+            out.miss_probes[k] += searchCounts[st].missProbes[k].load(memory_order_relaxed);
+        }
+        out.hits += out.hit_probes[k];
+        out.misses += out.miss_probes[k];
+    }
+    for (size_type st = 0; st < STAT_STRIPES; ++st)
+        out.filtered += searchCounts[st].filtered.load(memory_order_relaxed);
+    out.misses += out.filtered;
+    out.rehashes = numRehashes.load(memory_order_relaxed);
+    out.rehash_seconds = rehashNanos.load(memory_order_relaxed) / 1e9;
+    out.bytes_allocated = (capacity + oldCapacity) * sizeof(Item)
+                          + arenaBytes + filter_bytes();
+    out.bytes_mapped = 0;
+    for (size_type m = 0; m < mappings.size(); ++m)
+        out.bytes_mapped += mappings[m]->size();
+
+    vector<size_type> counts;
+    probe_histogram(counts);
+    double steps = 0;
+    for (size_type k = 0; k < counts.size(); ++k)
+        steps += double(k) * counts[k];
+    out.max_displacement = counts.empty() ? 0 : counts.size() - 1;
+    out.mean_displacement = used == 0 ? 0.0 : steps / used;
+
+    size_type runs = 0, runSlots = 0, run = 0;
+    out.longest_run = 0;
+    for (size_type i = 0; i <= capacity; ++i)
+    {
+        if (i < capacity && data[i].in_use())
+        {
+            ++run;
+            continue;
+        }
+        if (run > 0)
+        {
+            ++runs;
+            runSlots += run;
+            if (run > out.longest_run)
+                out.longest_run = run;
+        }
+        run = 0;
+    }
+    out.mean_run = runs == 0 ? 0.0 : double(runSlots) / runs;
+
+    vector<size_type> rows;
+    scat_counts(rows);
+    double mean = 0, var = 0;
+    for (size_type r = 0; r < rows.size(); ++r)
+        mean += rows[r];
+    mean /= rows.size();
+    for (size_type r = 0; r < rows.size(); ++r)
+        var += (rows[r] - mean) * (rows[r] - mean);
+    var /= rows.size();
+    out.row_cv = mean > 0 ? sqrt(var) / mean : 0.0;
+}
+
+// zeroes the search and rehash counters of the statistics
+void HashTable::reset_stats()
+{
+    for (size_type st = 0; st < STAT_STRIPES; ++st)
+    {
+        for (size_type k = 0; k < HashTableStats::PROBE_BUCKETS; ++k)
+        {
+            searchCounts[st].hitProbes[k].store(0, memory_order_relaxed);
+            searchCounts[st].missProbes[k].store(0, memory_order_relaxed);
+        }
+        searchCounts[st].filtered.store(0, memory_order_relaxed);
+    }
+    numRehashes.store(0, memory_order_relaxed);
+    rehashNanos.store(0, memory_order_relaxed);
+}
+
+// returns true if an incremental rehash is in progress
+bool HashTable::rehashing() const
+{ return oldData != 0; }
+
 // returns load-factor calculated as a fraction
 double HashTable::load_factor() const
 { return double(used) / capacity; }
 
-// returns hash value computed using the djb2 hash algorithm
-// (2nd page of Lecture Note 324s02AdditionalNotesOnHashFunctions)
-HashTable::size_type HashTable::hash(const string& word) const
+// returns hash value computed using the hash table's hash function
+// policy (djb2 by default, see HashFunctions.h); reduced to a slot
+// index by home_slot
+uint64_t HashTable::hash(string_view word) const
+{
+    return hash_word(hashKind, word);
+}
+
+// returns the capacity a rehash grows a hash table of capacity from
+// to: the prime number closest to and greater than 2 times from
+// (PRIME_MOD) or 2 times from (FIBONACCI)
+HashTable::size_type HashTable::grown_capacity(size_type from) const
 {
-    // All this code is directly from the notes + Q&A section
-    unsigned long hash = 5381; int c;
+    return reduction == PRIME_MOD ? next_prime(from * 2) : from * 2;
+}
 
-        for(int i = 0; i < word.length(); i++ )
-    {
-        c = word[i];
-        hash = ((hash << 5) + hash) + c; // hash*33 + c
-        
-    }
-    return (hash % capacity); // Mod to fit within capacity
+// grows the hash table (if needed) so that numWords words fit without
+// any further rehash; the capacity is the one that inserting them one
+// at a time would have grown it to
+void HashTable::reserve(size_type numWords)
+{
+    size_type newCapacity = capacity;
+    while (double(numWords + tombs) / newCapacity > .45)
+        newCapacity = grown_capacity(newCapacity);
+    if (newCapacity != capacity)
+        rehash(newCapacity);
 }
 
-// constructs an empty initial hash table
-HashTable::HashTable(size_type initial_capacity)
-: capacity(initial_capacity), used(0)
+// constructs an empty initial hash table that hashes with the given
+// policy; for PRIME_MOD the capacity is made prime, for FIBONACCI it
+// is rounded up to a power of 2
+HashTable::HashTable(size_type initial_capacity, HashKind hash_kind,
+                     Reduction reduction)
+: arenaNext(0), arenaLeft(0),
+  capacity(initial_capacity), used(0), tombs(0), hashKind(hash_kind),
+  reduction(reduction),
+  oldData(0), oldCapacity(0), migrated(0), incremental(false),
+  filtering(false), arenaBytes(0)
 {
+    reset_stats();
     if (capacity < 11)
-        capacity = next_prime(INIT_CAP);
+        capacity = INIT_CAP;
+    if (reduction == FIBONACCI)
+    {
+        size_type pow2 = 16;
+        while (pow2 < capacity)
+            pow2 *= 2;
+        capacity = pow2;
+    }
     else if ( ! is_prime(capacity))
         capacity = next_prime(capacity);
-    data = new Item[capacity];
-    for (size_type i = 0; i < capacity; ++i)
-        data[i].word = "";
+    data = new_slots(capacity); // Items start out vacant
 }
 
 // returns dynamic memory used by the hash table to heap
-HashTable::~HashTable() { delete [] data; }
+HashTable::~HashTable()
+{
+    free(data);
+    free(oldData);
+}
+
+// returns an array of numSlots vacant (all-zero) slots, to be released
+// with free; calloc hands back fresh zero pages for large arrays, so
+// they don't have to be cleared one slot at a time
+HashTable::Item* HashTable::new_slots(size_type numSlots)
+{
+    Item* slots = static_cast<Item*>(calloc(numSlots, sizeof(Item)));
+    if (slots == 0)
+        throw bad_alloc();
+    return slots;
+}
 
 // returns the hash table's current capacity
 HashTable::size_type HashTable::cap() const
 { return capacity; }
 
-// returns the # of hash-table slots currently in use (non-vacant)
+// returns the # of words currently in the hash table
 HashTable::size_type HashTable::size() const
 { return used; }
 
+// returns the # of tombstones (slots of erased words not yet reused
+// or compacted away) currently in the hash table
+HashTable::size_type HashTable::erased() const
+{ return tombs; }
+
 // graphs a horizontal histogram that gives a decent idea of how
 // items are distributed over the hash table
 void HashTable::scat_plot(ostream& out) const
 {
-    out << endl << "Scatter plot of where hash table is used:";
-    size_type lo_index = 0,
-    hi_index = capacity - 1,
-    width;
-    if (capacity >= 100000)
-        width = capacity / 250;
-    else if (capacity >= 10000)
-        width = capacity / 25;
-    else
-        width = capacity / 10;
-    size_type max_digits = size_type( floor( log10(hi_index) ) + 1 ),
-    label_beg  = lo_index,
-    label_end  = label_beg + width - 1;
-    for(label_beg = lo_index; label_beg <= hi_index; label_beg += width)
+    plot_slots(out, capacity, [this](size_type i) { return data[i].in_use(); });
+}
+
+// returns true if slot i (i < cap()) of the hash table holds a word
+bool HashTable::slot_in_use(size_type i) const
+{ return data[i].in_use(); }
+
+// rows[r] is set to the # of slots in use in row r of the scatter plot
+// (how scat_plot groups the slots), for measuring clustering
+void HashTable::scat_counts(vector<size_type>& rows) const
+{
+    rows = slot_rows(capacity, [this](size_type i) { return data[i].in_use(); });
+}
+
+// counts[k] is set to the # of words found on the k-th step of their
+// probe sequence (counts[0] for words in their home slot), i.e. the
+// distribution of successful search costs
+void HashTable::probe_histogram(vector<size_type>& counts) const
+{
+    counts.clear();
+    for (size_type i = 0; i < capacity; ++i)
     {
-        out << endl;
-        if( label_end > hi_index)
-            out << setw(max_digits) << label_beg << " - " << setw(max_digits) << hi_index << ": ";
-        else
-            out << setw(max_digits) << label_beg << " - " << setw(max_digits) << label_end << ": ";
-        size_type i = label_beg;
-        while ( i <= label_end && i <= hi_index)
-        {
-            if ( ! data[i].word.empty() )
-                out << '*';
-            ++i;
-        }
-        label_end = label_end + width;
+        if ( ! data[i].in_use() )
+            continue;
+        size_type home = home_slot(data[i].hash, capacity, reduction);
+        size_type index = home, numLoops = 0;
+        while (index != i)
+            index = probe_slot(home, ++numLoops, capacity, reduction);
+        if (counts.size() <= numLoops)
+            counts.resize(numLoops + 1, 0);
+        ++counts[numLoops];
     }
-    out << endl << endl;
 }
 
 // dumping to out contents of "segment of slots" of the hash table
@@ -149,42 +620,373 @@ void HashTable::grading_helper_print(ostream& out) const
 {
     out << endl << "Content of selected hash table segment:\n";
     for (size_type i = 10; i < 30; ++i)
-        out << '[' << i << "]: " << data[i].word << endl;
+        out << '[' << i << "]: " << data[i].word() << endl;
 }
 
-// sWord (assumed to be currently non-existant in the hash table)
-// is inserted into the hash table, using the djb2 hash function
-// and quadratic probing for collision resolution
+// if sWord is not in the hash table yet, it is copied into storage
+// owned by the hash table and inserted into the hash table, using the
+// hash table's hash function (djb2 by default) and quadratic probing
+// for collision resolution, and true is returned; otherwise (sWord
+// already in the hash table) false is returned
+// (the one probe sequence walked both looks for sWord and finds the
+// slot to put it in)
 // (if the insertion results in the load-factor exceeding 0.45,
 // rehash is called to bring down the load-factor)
-void HashTable::insert(const string& sWord)
+// (an empty word is not inserted, as it can't be told from a free slot)
+bool HashTable::insert(string_view sWord)
 {
-    size_type toIns = hash(sWord); // Hashing string to insert
+    if (sWord.empty())
+        return false;
+    return add(sWord, hash(sWord), true);
+}
+
+// as insert, for sWord whose hash value (with the hash table's hash
+// function policy) is h; its chars are copied into the arena if copy
+// is true, otherwise they must outlive the hash table
+bool HashTable::insert_hashed(string_view sWord, uint64_t h, bool copy)
+{
+    if (sWord.empty())
+        return false;
+    return add(sWord, h, copy);
+}
+
+// sWord, whose hash value is h, is put in the hash table unless it's
+// already there (then false is returned); its chars are copied into
+// the arena if copy is true, otherwise they must outlive the hash table
+// (an incremental rehash in progress is advanced by MIGRATE_STEP slots)
+bool HashTable::add(string_view sWord, uint64_t h, bool copy)
+{
+    migrate(MIGRATE_STEP);
+    size_type index, numProbes;
+    if ( probe_insert(sWord, h, index)
+         || (oldData != 0 && search_in(oldData, oldCapacity, sWord, h, numProbes)) )
+        return false;
+    put(index, copy ? store(sWord) : sWord.data(), uint32_t(sWord.length()), h);
+    return true;
+}
+
+// copies sWord into the arena and returns where its chars now are
+// (a new chunk is started when the current one is too full; chars
+// once stored never move)
+const char* HashTable::store(string_view sWord)
+{
+    if (sWord.length() > arenaLeft)
+    {
+        arenaLeft = sWord.length() > ARENA_CHUNK ? sWord.length() : ARENA_CHUNK;
+        arena.push_back(unique_ptr<char[]>(new char[arenaLeft]));
+        arenaBytes += arenaLeft;
+        arenaNext = arena.back().get();
+    }
+    char* at = arenaNext;
+    memcpy(at, sWord.data(), sWord.length());
+    arenaNext += sWord.length();
+    arenaLeft -= sWord.length();
+    return at;
+}
+
+// the word of length chars at chars (which must outlive the hash table
+// and is assumed to be currently non-existant in it) whose hash value
+// is h is placed in the first vacant slot along its quadratic probe
+// sequence
+// (a tombstone along the way is reused)
+// (an incremental rehash in progress is advanced by MIGRATE_STEP slots)
+void HashTable::place(const char* chars, uint32_t length, uint64_t h)
+{
+    migrate(MIGRATE_STEP);
+    put(probe_vacant(h), chars, length, h);
+}
+
+// the word of length chars at chars whose hash value is h is put in
+// slot index of data (a vacant slot or tombstone)
+// (if the insertion results in the slots in use and tombstones
+// together exceeding 0.45 of the capacity, rehash is called to bring
+// that down: the hash table is grown, or only compacted if tombstones
+// account for most of it)
+// (if filtering and the filter has had more words added than it was
+// sized for, it is rebuilt from the words in use, with room for at
+// least as many words again as there are, or for 0.45 of the capacity,
+// so that rebuilds stay rare)
+void HashTable::put(size_type index, const char* chars, uint32_t length,
+                    uint64_t h)
+{
+    if (data[index].deleted())
+        --tombs;
+    data[index].chars = chars;
+    data[index].length = length;
+    data[index].hash = h;
+    if (filtering)
+    {
+        filter.add(h);
+        if (filter.overfull()) // Erased words crowding it: starting afresh
+            rebuild_filter(max(size_type(capacity * .45), 2 * (used + 1)) + 1);
+    }
+    ++used; // Incrementing used to reflect added item
+    if(double(used + tombs) / capacity > .45) // rehash is called to bring down the load-factor
+    {
+        rehash(load_factor() > .225 ? grown_capacity(capacity) : capacity);
+    }
+    
+}
+
+// removes sWord from the hash table, leaving a tombstone in its slot
+// so that the probe sequences of other words stay intact; returns
+// false if sWord isn't in the hash table
+// (once tombstones take up more than MAX_TOMB_PCT percent of the
+// capacity the hash table is compacted by a rehash at the same
+// capacity; the chars of an erased word are only released with the
+// hash table or its dictionary mapping)
+// (while an incremental rehash is in progress sWord is erased from
+// both tables, since the drained table keeps copies of moved words)
+bool HashTable::erase(string_view sWord)
+{
+    return erase_hashed(sWord, hash(sWord));
+}
+
+// as erase, for sWord whose hash value (with the hash table's hash
+// function policy) is h
+bool HashTable::erase_hashed(string_view sWord, uint64_t h)
+{
+    migrate(MIGRATE_STEP);
+    bool inData = erase_in(data, capacity, sWord, h);
+    bool inOld = oldData != 0 && erase_in(oldData, oldCapacity, sWord, h);
+    if ( ! inData && ! inOld )
+        return false;
+    if (inData)
+        ++tombs;
+    --used;
+    if (tombs * 100 > capacity * MAX_TOMB_PCT)
+        rehash(capacity);
+#ifdef DEBUG
+    assert(verify());
+#endif
+    return true;
+}
+
+// returns the index of the first vacant slot (or tombstone) along the
+// quadratic probe sequence of hash value h in data
+HashTable::size_type HashTable::probe_vacant(uint64_t h) const
+{
+    size_type toIns = home_slot(h, capacity, reduction); // Home slot of the word to insert
     size_type index = toIns; // Creating traversal variables
     size_type numLoops = 0;
-    bool inserted = false;
-    
-    do
+    while ( data[index].in_use() ) // Resolve w/ quadratic probing
     {
-        ++numLoops; // Variable only used for quadratic probing
-        if (data[index].word[0] == '\0') // Current string is empty
+        ++numLoops;
+        index = probe_slot(toIns, numLoops, capacity, reduction);
+    }
+    return index;
+}
+
+// returns true if sWord (whose hash value is h) is found along its
+// quadratic probe sequence in data; otherwise returns false and sets
+// index to the first tombstone along the sequence, or to the vacant
+// slot that ends it if there's no tombstone before that
+bool HashTable::probe_insert(string_view sWord, uint64_t h,
+                             size_type& index) const
+{
+    size_type home = home_slot(h, capacity, reduction);
+    size_type slot = home;
+    bool haveTomb = false;
+    for (size_type numLoops = 0; ! data[slot].vacant(); )
+    {
+        if (data[slot].deleted())
         {
-            data[index].word = sWord; // '=' doesnt work for some reason
-            ++used; // Incrementing used to reflect added item
-            inserted = true;
+            if ( ! haveTomb )
+            {
+                index = slot;
+                haveTomb = true;
+            }
         }
-        else // Current string not empty; resolve w/ quadratic probing
+        else if (data[slot].hash == h && data[slot].word() == sWord)
+            return true;
+        slot = probe_slot(home, ++numLoops, capacity, reduction);
+    }
+    if ( ! haveTomb )
+        index = slot;
+    return false;
+}
+
+// maps the dictionary file at path into memory and inserts each of
+// its whitespace separated words not already in the hash table; the
+// words are views into the mapping (kept open for the hash table's
+// lifetime) so no per-word copies are made
+// returns false (hash table unchanged) if the file can't be mapped
+bool HashTable::load(const char* path)
+{
+    unique_ptr<MappedFile> file(new MappedFile);
+    if ( ! file->open(path) )
+        return false;
+    const char* end = file->end();
+    const char* p = skip_space(file->begin(), end);
+    while (p < end)
+    {
+        const char* wordEnd = skip_word(p, end);
+        string_view oneWord(p, size_type(wordEnd - p));
+        add(oneWord, hash(oneWord), false);
+        p = skip_space(wordEnd, end);
+    }
+    mappings.push_back(std::move(file));
+#ifdef DEBUG
+    assert(verify());
+#endif
+    return true;
+}
+
+// does what load does, with the work spread over numThreads threads
+// (the # of hardware threads if 0):
+//   1. each thread tokenizes and hashes one chunk of the file (chunks
+//      are split at whitespace) and sorts its words into 2^SHARD_BITS
+//      shards by the high bits of their (mixed) hash values
+//   2. the shards are taken in turn by the threads, which drop the
+//      duplicate words of each (a duplicate is always in the same
+//      shard, so no two threads ever compare the same words)
+//   3. the hash table is grown once to fit all distinct words, which
+//      are then placed using the hash values computed in 1.
+// only 3. is sequential, and it neither hashes nor compares any word
+// unless the hash table already had words before the load
+// returns false (hash table unchanged) if the file can't be mapped
+bool HashTable::load_parallel(const char* path, unsigned numThreads)
+{
+    unique_ptr<MappedFile> file(new MappedFile);
+    if ( ! file->open(path) )
+        return false;
+    if (numThreads == 0)
+        numThreads = thread::hardware_concurrency();
+    if (numThreads == 0)
+        numThreads = 1;
+    const size_type numShards = size_type(1) << SHARD_BITS;
+
+    vector<const char*> bounds(numThreads + 1);
+    bounds[0] = file->begin();
+    bounds[numThreads] = file->end();
+    for (unsigned t = 1; t < numThreads; ++t)
+    {
+        const char* p = file->begin() + file->size() * t / numThreads;
+        bounds[t] = skip_word(p < bounds[t - 1] ? bounds[t - 1] : p, file->end());
+    }
+    vector<vector<vector<Item>>> parts(numThreads, vector<vector<Item>>(numShards));
+    run_threads(numThreads, [&](unsigned t)
+    {
+        const char* end = bounds[t + 1];
+        const char* p = skip_space(bounds[t], end);
+        while (p < end)
         {
-            index = (toIns + (numLoops * numLoops)) % capacity;
+            const char* wordEnd = skip_word(p, end);
+            Item item;
+            item.chars = p;
+            item.length = uint32_t(wordEnd - p);
+            item.hash = hash(item.word());
+            parts[t][mix(item.hash) >> (64 - SHARD_BITS)].push_back(item);
+            p = skip_space(wordEnd, end);
+        }
+    });
+
+    vector<vector<Item>> shards(numShards);
+    atomic<size_type> nextShard(0);
+    run_threads(numThreads, [&](unsigned)
+    {
+        vector<uint32_t> seen; // open-addressing set of shard word #s + 1
+        for (size_type sh; (sh = nextShard++) < numShards; )
+        {
+            size_type count = 0;
+            for (unsigned t = 0; t < numThreads; ++t)
+                count += parts[t][sh].size();
+            unsigned seenBits = 4;
+            while ((size_type(1) << seenBits) < 2 * count)
+                ++seenBits;
+            seen.assign(size_type(1) << seenBits, 0);
+            vector<Item>& words = shards[sh];
+            words.reserve(count);
+            for (unsigned t = 0; t < numThreads; ++t)
+            {
+                for (size_type i = 0; i < parts[t][sh].size(); ++i)
+                {
+                    const Item& item = parts[t][sh][i];
+                    size_type mask = seen.size() - 1;
+                    size_type index = (mix(item.hash) << SHARD_BITS) >> (64 - seenBits);
+                    for ( ; seen[index] != 0; index = (index + 1) & mask)
+                    {
+                        const Item& other = words[seen[index] - 1];
+                        if (other.hash == item.hash && other.word() == item.word())
+                            break;
+                    }
+                    if (seen[index] == 0)
+                    {
+                        words.push_back(item);
+                        seen[index] = uint32_t(words.size());
+                    }
+                }
+                vector<Item>().swap(parts[t][sh]); // releasing the part
+            }
+        }
+    });
+
+    bool wasEmpty = used == 0; // (then no word needs to be looked for)
+    size_type total = 0;
+    for (size_type sh = 0; sh < numShards; ++sh)
+        total += shards[sh].size();
+    reserve(used + total);
+    for (size_type sh = 0; sh < numShards; ++sh)
+    {
+        for (size_type i = 0; i < shards[sh].size(); ++i)
+        {
+            const Item& item = shards[sh][i];
+            if (wasEmpty)
+                place(item.chars, item.length, item.hash);
+            else
+                add(item.word(), item.hash, false);
         }
-        
     }
-    while(!inserted);
-    if(load_factor() > .45) // rehash is called to bring down the load-factor
+    mappings.push_back(std::move(file));
+#ifdef DEBUG
+    assert(verify());
+#endif
+    return true;
+}
+
+// writes the hash table to path as a snapshot (see HashSnapshot.h):
+// a header, the slot array (offset and length of each slot's word
+// in the string arena, length 0 for vacant slots) and the arena of
+// word chars, so that HashSnapshot can search the file in place
+// returns false if the file can't be written
+// (an incremental rehash in progress is completed first, and the hash
+// table is compacted if it has tombstones, since a snapshot reader
+// can't tell them from vacant slots)
+bool HashTable::save(const char* path)
+{
+    if (tombs > 0)
+        rehash(capacity);
+    migrate(oldCapacity);
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.slot_bytes = sizeof(SnapshotSlot);
+    header.capacity = capacity;
+    header.used = used;
+    header.hash_seed = hash_seed(hashKind);
+    header.hash_kind = hashKind;
+    header.reduction = reduction;
+    vector<SnapshotSlot> slots(capacity);
+    for (size_type i = 0; i < capacity; ++i)
     {
-        rehash();
+        slots[i].offset = uint32_t(header.arena_bytes);
+        slots[i].length = data[i].length;
+        header.arena_bytes += data[i].length;
+        if (header.arena_bytes > UINT32_MAX) // offsets are 32-bit
+            return false;
     }
-    
+    ofstream fout(path, ios::out | ios::binary | ios::trunc);
+    if ( fout.fail() )
+        return false;
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fout.write(reinterpret_cast<const char*>(slots.data()),
+               streamsize(capacity * sizeof(SnapshotSlot)));
+    for (size_type i = 0; i < capacity; ++i)
+        if (data[i].in_use())
+            fout.write(data[i].chars, streamsize(data[i].length));
+    fout.close();
+    return ! fout.fail();
 }
 
 // adaptation of : http://stackoverflow.com/questions/4475996
@@ -4,33 +4,173 @@
 #include <cstdlib>  // for use of size_t
 #include <iostream> // for use of ostream
 #include <string>   // for use of string
+#include <string_view> // for use of string_view
+#include <cstdint>  // for use of uint32_t, uint64_t
+#include <memory>   // for use of unique_ptr
+#include <vector>   // for use of vector
+#include <atomic>   // for use of atomic
+#include <chrono>   // for use of steady_clock
+#include "MappedFile.h"
+#include "HashFunctions.h"
+#include "BloomFilter.h"
+
+// snapshot of a HashTable's statistics (see HashTable::stats): search
+// counters accumulated since construction or reset_stats, and figures
+// computed from the slots when the snapshot is taken
+// (a probe length is the # of probe steps a search took after its home
+// slot; the last histogram entry also counts all longer searches)
+struct HashTableStats
+{
+    static const size_t PROBE_BUCKETS = 16;
+    HashKind hash_kind;         // hash function policy
+    Reduction reduction;        // hash value -> slot mapping
+    size_t capacity;            // slots (of the current slot array)
+    size_t used;                // words
+    size_t tombstones;          // slots of erased words
+    uint64_t hits;              // searches that found their word
+    uint64_t misses;            // searches that didn't (filtered included)
+    uint64_t filtered;          // misses the Bloom filter turned away
+    uint64_t hit_probes[PROBE_BUCKETS];  // hits by probe length
+    uint64_t miss_probes[PROBE_BUCKETS]; // probed misses by probe length
+    size_t max_displacement;    // longest probe length of a stored word
+    double mean_displacement;   // mean probe length of the stored words
+    uint64_t rehashes;          // rehashes (growths and compactions)
+    double rehash_seconds;      // time spent in them
+    size_t bytes_allocated;     // heap bytes: slots, word arena, filter
+    size_t bytes_mapped;        // bytes of dictionary files mapped
+    size_t longest_run;         // longest run of consecutive used slots
+    double mean_run;            // mean length of such runs
+    double row_cv;              // coefficient of variation of the # of
+                                // used slots per scatter plot row
+};
 
 class HashTable
 {
 public:
     typedef size_t size_type;
     static const size_type INIT_CAP = 101;
-    // default | 1-argument constructor
-    HashTable(size_type initial_capacity = INIT_CAP);
+    // default | 1-argument | 2-argument | 3-argument constructor
+    HashTable(size_type initial_capacity = INIT_CAP,
+              HashKind hash_kind = DJB2_HASH,
+              Reduction reduction = PRIME_MOD);
     ~HashTable();
     size_type cap() const;
     size_type size() const;
-    bool exists(const std::string& sWord) const;
-    bool search(const std::string& sWord) const;
+    bool exists(std::string_view sWord) const;
+    bool search(std::string_view sWord) const;
+    void search_batch(const std::string_view* words, size_type count,
+                      bool* found) const;
     double load_factor() const;
     void scat_plot(std::ostream& out) const;
+    void scat_counts(std::vector<size_type>& rows) const;
+    void probe_histogram(std::vector<size_type>& counts) const;
     void grading_helper_print(std::ostream& out) const;
-    void insert(const std::string& sWord);
+    bool insert(std::string_view sWord);
+    bool erase(std::string_view sWord);
+    // for tables made of HashTables (the segments of a StripedHashTable)
+    // that hash a word once, with hash_word and the same policy, and
+    // hand the hash value on
+    bool insert_hashed(std::string_view sWord, uint64_t h, bool copy = true);
+    bool search_hashed(std::string_view sWord, uint64_t h) const;
+    bool erase_hashed(std::string_view sWord, uint64_t h);
+    bool slot_in_use(size_type i) const;
+    size_type erased() const;
+    void reserve(size_type numWords);
+    bool load(const char* path);
+    bool load_parallel(const char* path, unsigned numThreads = 0);
+    bool save(const char* path);
+    void set_incremental(bool enable);
+    bool rehashing() const;
+    void set_filter(bool enable);
+    size_type filter_bytes() const;
+    void stats(HashTableStats& out) const;
+    void reset_stats();
+#ifdef DEBUG
+    bool verify() const;
+#endif
 private:
+    // a slot is vacant (never used), in use or a tombstone (its word
+    // was erased); a tombstone keeps the probe sequences that pass
+    // through it intact and is reused by a later insert
+    // (slots only describe their word, so they are plain data that is
+    // zero-filled when allocated and copied as is by rehash)
+    static const char TOMBSTONE[1]; // chars a tombstone points at
     struct Item
     {
-        std::string word;  // word as string
+        const char* chars;  // word's chars (arena or mapping), 0 if vacant
+        uint32_t length;    // # of chars of the word (0 if not in use)
+        uint64_t hash;      // hash value of the word
+        std::string_view word() const { return std::string_view(chars, length); }
+        bool vacant() const { return chars == 0; }
+        bool deleted() const { return chars == TOMBSTONE; }
+        bool in_use() const { return length != 0; }
     };
     Item* data;
+    // chars of words added by insert are bump-allocated out of chunks
+    std::vector<std::unique_ptr<char[]>> arena;
+    char* arenaNext;    // next free byte of arena.back()
+    size_type arenaLeft; // # of free bytes from arenaNext on
+    std::vector<std::unique_ptr<MappedFile>> mappings; // files loaded
+    static const size_type BATCH_SIZE = 16; // lookups overlapped by search_batch
+    static const unsigned SHARD_BITS = 6;   // load_parallel uses 2^SHARD_BITS shards
     size_type capacity; // hash table capacity
-    size_type used;     // # of hash table elements used (non-vacant)
-    size_type hash(const std::string& word) const;
+    size_type used;     // # of words in the hash table
+    size_type tombs;    // # of tombstones in data
+    static const size_type MAX_TOMB_PCT = 20; // compaction threshold
+    HashKind hashKind;  // hash function policy
+    Reduction reduction; // hash value -> slot mapping (and probing)
+    // incremental rehash: the table being drained into data (0 if
+    // none), its capacity, and how many of its slots have been moved
+    static const size_type MIGRATE_STEP = 8; // old slots moved per insert
+    Item* oldData;
+    size_type oldCapacity;
+    size_type migrated;
+    bool incremental;   // true if rehash is to be done incrementally
+    // optional Bloom filter of the hash values of the words, refilled
+    // by every rehash (it can't forget erased words, a rehash drops
+    // them), and by put once more words have been added to it than it
+    // was sized for (words erased and inserted again and again, into
+    // tombstones, never cause a rehash); during an incremental rehash
+    // it is filled as words are moved, and the filter of the table
+    // being drained is kept too
+    BloomFilter filter;
+    BloomFilter oldFilter;
+    bool filtering;     // true if searches consult filter first
+    size_type arenaBytes; // # of bytes of the arena's chunks
+    // statistics counters; relaxed atomics so that concurrent searches
+    // can count without synchronizing, and the search counters split
+    // into cache line aligned stripes (threads take turns picking one,
+    // wrapping around) that stats adds up, so that threads searching
+    // at the same time rarely count on the same cache line
+    static const size_type STAT_STRIPES = 16;
+    struct alignas(64) SearchCounts
+    {
+        std::atomic<uint64_t> hitProbes[HashTableStats::PROBE_BUCKETS];
+        std::atomic<uint64_t> missProbes[HashTableStats::PROBE_BUCKETS];
+        std::atomic<uint64_t> filtered;
+    };
+    mutable SearchCounts searchCounts[STAT_STRIPES];
+    std::atomic<uint64_t> numRehashes;
+    std::atomic<uint64_t> rehashNanos;
+    uint64_t hash(std::string_view word) const;
+    size_type grown_capacity(size_type from) const;
     void rehash();
+    void rehash(size_type newCapacity);
+    static Item* new_slots(size_type numSlots);
+    const char* store(std::string_view sWord);
+    bool add(std::string_view sWord, uint64_t h, bool copy);
+    void place(const char* chars, uint32_t length, uint64_t h);
+    void put(size_type index, const char* chars, uint32_t length, uint64_t h);
+    size_type probe_vacant(uint64_t h) const;
+    bool probe_insert(std::string_view sWord, uint64_t h, size_type& index) const;
+    bool search_in(const Item* items, size_type itemCap,
+                   std::string_view sWord, uint64_t h,
+                   size_type& numProbes) const;
+    bool erase_in(Item* items, size_type itemCap,
+                  std::string_view sWord, uint64_t h);
+    void migrate(size_type numSlots);
+    void rebuild_filter(size_type maxKeys);
+    void count_rehash(std::chrono::steady_clock::time_point beg);
     
     // disable copy construction & copy assignment
     HashTable(const HashTable& src) { }
@@ -0,0 +1,70 @@
+#include "MappedFile.h"
+#include <fcntl.h>    // for use of open
+#include <unistd.h>   // for use of close
+#include <sys/mman.h> // for use of mmap, munmap
+#include <sys/stat.h> // for use of fstat
+
+// constructs an object with nothing mapped
+MappedFile::MappedFile() : bytes(0), length(0) { }
+
+// unmaps the file (if any)
+MappedFile::~MappedFile() { close(); }
+
+// maps the whole file at path read-only, replacing any previous
+// mapping; returns false (with nothing mapped) if the file cannot be
+// opened or mapped (an empty file is mapped as 0 bytes)
+bool MappedFile::open(const char* path)
+{
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    length = size_t(info.st_size);
+    if (length > 0)
+    {
+        void* addr = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            ::close(fd);
+            length = 0;
+            return false;
+        }
+        madvise(addr, length, MADV_SEQUENTIAL); // read front to back
+        bytes = static_cast<const char*>(addr);
+    }
+    else
+        bytes = "";
+    ::close(fd); // the mapping keeps its own reference to the file
+    return true;
+}
+
+// unmaps the file (if any)
+void MappedFile::close()
+{
+    if (bytes != 0 && length > 0)
+        munmap(const_cast<char*>(bytes), length);
+    bytes = 0;
+    length = 0;
+}
+
+// returns true if a file is currently mapped
+bool MappedFile::is_open() const
+{ return bytes != 0; }
+
+// returns the address of the first mapped byte
+const char* MappedFile::begin() const
+{ return bytes; }
+
+// returns the address one past the last mapped byte
+const char* MappedFile::end() const
+{ return bytes + length; }
+
+// returns the # of bytes mapped
+size_t MappedFile::size() const
+{ return length; }
@@ -0,0 +1,28 @@
+#ifndef MAPPED_FILE
+#define MAPPED_FILE
+
+#include <cstdlib>  // for use of size_t
+
+// read-only memory mapping of a whole file; the bytes stay valid
+// (and at the same address) until the object is destroyed
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    bool open(const char* path);
+    void close();
+    bool is_open() const;
+    const char* begin() const;
+    const char* end() const;
+    size_t size() const;
+private:
+    const char* bytes; // start of the mapping (0 if nothing mapped)
+    size_t length;     // # of bytes mapped
+
+    // disable copy construction & copy assignment
+    MappedFile(const MappedFile& src);
+    void operator=(const MappedFile& rhs);
+};
+
+#endif
@@ -0,0 +1,283 @@
+#include "PerfectHash.h"
+#include "ScatPlot.h"
+#include "TextScan.h"
+#include <fstream>   // for use of ofstream
+#include <algorithm> // for use of sort
+#include <cstring>   // for use of memcmp, memcpy, memset
+using namespace std;
+
+// seeds tried in turn by write_perfect_hash, and the # of pilots tried
+// for a bucket before a seed is given up on
+static const uint64_t SEEDS[] = { 0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL,
+                                  0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL };
+static const uint32_t MAX_PILOT = 1u << 24;
+
+// returns x with its bits thoroughly mixed (splitmix64 finalizer)
+static inline uint64_t remix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// returns x scaled from [0, 2^64) down to [0, n) (multiply-shift,
+// which keeps the high bits of x and needs no division)
+static inline size_t scale(uint64_t x, size_t n)
+{
+    return size_t((unsigned __int128)x * n >> 64);
+}
+
+uint64_t word_key(HashKind kind, uint64_t seed, string_view word)
+{
+    return remix(hash_word(kind, word) ^ seed);
+}
+
+size_t key_bucket(uint64_t key, size_t numBuckets)
+{
+    return scale(key, numBuckets);
+}
+
+size_t key_slot(uint64_t key, uint32_t pilot, size_t numWords)
+{
+    return scale(remix(key ^ remix(pilot + 1)), numWords);
+}
+
+// pilots[] gets a pilot for each bucket such that the keys get one
+// slot each among slots[] (0 .. keys.size()-1); buckets are handled
+// largest first, while many slots are still free, and each takes the
+// first pilot that puts all its keys in free slots (different ones)
+// returns false if some bucket has no such pilot below MAX_PILOT
+// (which is what keys with equal values always run into)
+static bool find_pilots(const vector<uint64_t>& keys, size_t numBuckets,
+                        vector<uint32_t>& pilots, vector<uint32_t>& slots)
+{
+    size_t numKeys = keys.size();
+    // keys (by index) grouped by bucket: bucket b's keys are
+    // members[first[b] .. first[b+1])
+    vector<uint32_t> first(numBuckets + 1, 0), members(numKeys);
+    for (size_t k = 0; k < numKeys; ++k)
+        ++first[key_bucket(keys[k], numBuckets) + 1];
+    for (size_t b = 0; b < numBuckets; ++b)
+        first[b + 1] += first[b];
+    vector<uint32_t> next(first.begin(), first.end() - 1);
+    for (size_t k = 0; k < numKeys; ++k)
+        members[next[key_bucket(keys[k], numBuckets)]++] = uint32_t(k);
+    vector<uint32_t> order(numBuckets);
+    for (size_t b = 0; b < numBuckets; ++b)
+        order[b] = uint32_t(b);
+    stable_sort(order.begin(), order.end(), [&first](uint32_t a, uint32_t b)
+                { return first[a + 1] - first[a] > first[b + 1] - first[b]; });
+
+    vector<bool> taken(numKeys, false);
+    vector<size_t> tried;
+    pilots.assign(numBuckets, 0);
+    slots.assign(numKeys, 0);
+    for (size_t o = 0; o < numBuckets; ++o)
+    {
+        uint32_t b = order[o];
+        if (first[b + 1] == first[b])
+            break; // only empty buckets are left
+        uint32_t pilot = 0;
+        for ( ; pilot < MAX_PILOT; ++pilot)
+        {
+            tried.clear();
+            bool fits = true;
+            for (uint32_t m = first[b]; m < first[b + 1] && fits; ++m)
+            {
+                size_t slot = key_slot(keys[members[m]], pilot, numKeys);
+                fits = ! taken[slot]
+                       && find(tried.begin(), tried.end(), slot) == tried.end();
+                tried.push_back(slot);
+            }
+            if (fits)
+                break;
+        }
+        if (pilot == MAX_PILOT)
+            return false;
+        pilots[b] = pilot;
+        for (uint32_t m = first[b]; m < first[b + 1]; ++m)
+        {
+            size_t slot = key_slot(keys[members[m]], pilot, numKeys);
+            taken[slot] = true;
+            slots[members[m]] = uint32_t(slot);
+        }
+    }
+    return true;
+}
+
+bool write_perfect_hash(const vector<string_view>& words, const char* path,
+                        HashKind kind)
+{
+    size_t numWords = words.size();
+    size_t numBuckets = numWords / BUCKET_SIZE + 1;
+    vector<uint64_t> keys(numWords);
+    vector<uint32_t> pilots, slots;
+    uint64_t seed = 0;
+    bool found = false;
+    for (size_t s = 0; s < sizeof(SEEDS) / sizeof(SEEDS[0]) && ! found; ++s)
+    {
+        seed = SEEDS[s];
+        for (size_t i = 0; i < numWords; ++i)
+            keys[i] = word_key(kind, seed, words[i]);
+        found = find_pilots(keys, numBuckets, pilots, slots);
+    }
+    if ( ! found )
+        return false;
+
+    vector<uint32_t> wordAt(numWords); // word # in each slot
+    for (size_t i = 0; i < numWords; ++i)
+        wordAt[slots[i]] = uint32_t(i);
+    PerfectHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PERFECT_MAGIC, sizeof(header.magic));
+    header.version = PERFECT_VERSION;
+    header.hash_kind = kind;
+    header.num_words = numWords;
+    header.num_buckets = numBuckets;
+    header.seed = seed;
+    header.hash_seed = hash_seed(kind);
+    vector<uint32_t> offsets(numWords + 1, 0);
+    for (size_t i = 0; i < numWords; ++i)
+    {
+        header.arena_bytes += words[wordAt[i]].length();
+        if (header.arena_bytes > UINT32_MAX) // offsets are 32-bit
+            return false;
+        offsets[i + 1] = uint32_t(header.arena_bytes);
+    }
+    ofstream fout(path, ios::out | ios::binary | ios::trunc);
+    if ( fout.fail() )
+        return false;
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fout.write(reinterpret_cast<const char*>(pilots.data()),
+               streamsize(numBuckets * sizeof(uint32_t)));
+    fout.write(reinterpret_cast<const char*>(offsets.data()),
+               streamsize((numWords + 1) * sizeof(uint32_t)));
+    for (size_t i = 0; i < numWords; ++i)
+        fout.write(words[wordAt[i]].data(), streamsize(words[wordAt[i]].length()));
+    fout.close();
+    return ! fout.fail();
+}
+
+bool build_perfect_hash(const char* dictPath, const char* path, HashKind kind)
+{
+    MappedFile file;
+    if ( ! file.open(dictPath) )
+        return false;
+    vector<string_view> words;
+    const char* p = skip_space(file.begin(), file.end());
+    while (p < file.end())
+    {
+        const char* wordEnd = skip_word(p, file.end());
+        words.push_back(string_view(p, size_t(wordEnd - p)));
+        p = skip_space(wordEnd, file.end());
+    }
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    return write_perfect_hash(words, path, kind);
+}
+
+// constructs a table with nothing opened (0 capacity)
+PerfectHashTable::PerfectHashTable()
+: pilots(0), offsets(0), arena(0), numWords(0), numBuckets(0), seed(0),
+  hashKind(WY_HASH) { }
+
+// maps the perfect hash file at path and checks that its header and
+// arrays are consistent with the file's size, and that the word
+// offsets start at 0, never decrease and end at the end of the arena;
+// returns false (nothing opened) if the file can't be mapped or isn't
+// a perfect hash file of the current version (or is truncated or
+// corrupted)
+// (the counts are bounded by the file size before they are multiplied,
+// as a corrupted header's counts could make the product overflow)
+bool PerfectHashTable::open(const char* path)
+{
+    pilots = offsets = 0;
+    arena = 0;
+    numWords = numBuckets = 0;
+    if ( ! file.open(path) )
+        return false;
+    PerfectHeader header;
+    if (file.size() < sizeof(header))
+    {
+        file.close();
+        return false;
+    }
+    memcpy(&header, file.begin(), sizeof(header));
+    uint64_t maxValues = (file.size() - sizeof(header)) / sizeof(uint32_t);
+    if (memcmp(header.magic, PERFECT_MAGIC, sizeof(header.magic)) != 0
+        || header.version != PERFECT_VERSION
+        || header.hash_kind > XXH3_HASH
+        || header.hash_seed != hash_seed(HashKind(header.hash_kind))
+        || header.num_buckets == 0
+        || header.num_buckets >= maxValues
+        || header.num_words > maxValues - header.num_buckets - 1)
+    {
+        file.close();
+        return false;
+    }
+    uint64_t arrayBytes = (header.num_buckets + header.num_words + 1) * sizeof(uint32_t);
+    const uint32_t* fileOffsets =
+        reinterpret_cast<const uint32_t*>(file.begin() + sizeof(header)) + header.num_buckets;
+    bool valid = header.arena_bytes == file.size() - sizeof(header) - arrayBytes
+                 && fileOffsets[0] == 0
+                 && fileOffsets[header.num_words] == header.arena_bytes;
+    for (uint64_t i = 0; valid && i < header.num_words; ++i)
+        valid = fileOffsets[i] <= fileOffsets[i + 1];
+    if ( ! valid )
+    {
+        file.close();
+        return false;
+    }
+    pilots = reinterpret_cast<const uint32_t*>(file.begin() + sizeof(header));
+    offsets = fileOffsets;
+    arena = file.begin() + sizeof(header) + arrayBytes;
+    numWords = size_type(header.num_words);
+    numBuckets = size_type(header.num_buckets);
+    seed = header.seed;
+    hashKind = HashKind(header.hash_kind);
+    return true;
+}
+
+// returns the word stored in slot i
+string_view PerfectHashTable::word_at(size_type i) const
+{ return string_view(arena + offsets[i], offsets[i + 1] - offsets[i]); }
+
+// returns the table's capacity (its # of words, every slot being used)
+PerfectHashTable::size_type PerfectHashTable::cap() const
+{ return numWords; }
+
+// returns the # of words in the table
+PerfectHashTable::size_type PerfectHashTable::size() const
+{ return numWords; }
+
+// returns true if sWord can be found in the table: the only slot it
+// can be in is computed from its key and its bucket's pilot
+bool PerfectHashTable::search(string_view sWord) const
+{
+    if (numWords == 0)
+        return false;
+    uint64_t key = word_key(hashKind, seed, sWord);
+    size_type slot = key_slot(key, pilots[key_bucket(key, numBuckets)], numWords);
+    return word_at(slot) == sWord;
+}
+
+// returns load-factor calculated as a fraction (1 unless empty)
+double PerfectHashTable::load_factor() const
+{ return numWords == 0 ? 0.0 : 1.0; }
+
+// graphs a horizontal histogram that gives a decent idea of how
+// items are distributed over the table (evenly, every slot is used)
+void PerfectHashTable::scat_plot(ostream& out) const
+{
+    plot_slots(out, numWords, [](size_type) { return true; });
+}
+
+// dumping to out contents of "segment of slots" of the table
+void PerfectHashTable::grading_helper_print(ostream& out) const
+{
+    out << endl << "Content of selected hash table segment:\n";
+    for (size_type i = 10; i < 30 && i < numWords; ++i)
+        out << '[' << i << "]: " << word_at(i) << endl;
+}
@@ -0,0 +1,102 @@
+#ifndef PERFECT_HASH
+#define PERFECT_HASH
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint32_t, uint64_t
+#include <iostream>    // for use of ostream
+#include <string_view> // for use of string_view
+#include <vector>      // for use of vector
+#include "MappedFile.h"
+#include "HashFunctions.h"
+
+// MINIMAL PERFECT HASHING of a static word list (PTHash-style): the
+// n words are spread over n/BUCKET_SIZE buckets by their hash value,
+// and every bucket gets a "pilot", chosen when the file is built, such
+// that hashing each word together with its bucket's pilot gives it a
+// slot of its own among slots 0 .. n-1 (no collisions, no vacant
+// slots); a search hashes the word, reads its bucket's pilot, and
+// compares the word with the one word stored in the computed slot
+//
+// ON-DISK LAYOUT of a perfect hash file (written by write_perfect_hash):
+//   PerfectHeader                        (fixed size, 64 bytes)
+//   uint32_t pilots[num_buckets]
+//   uint32_t offsets[num_words + 1]      (slot i's word is arena
+//                                         [offsets[i], offsets[i+1]))
+//   char[arena_bytes]                    (the words, in slot order)
+// Values are stored in the byte order of the machine that wrote the
+// file.
+const char PERFECT_MAGIC[8] = { 'H', 'T', 'P', 'H', 'A', 'S', 'H', '\0' };
+const uint32_t PERFECT_VERSION = 1;
+const uint32_t BUCKET_SIZE = 4; // average # of words per bucket
+
+struct PerfectHeader
+{
+    char magic[8];        // PERFECT_MAGIC
+    uint32_t version;     // PERFECT_VERSION
+    uint32_t hash_kind;   // HashKind of the hash function policy
+    uint64_t num_words;   // # of words (= # of slots)
+    uint64_t num_buckets; // # of buckets (= # of pilots)
+    uint64_t seed;        // mixed into every hash value (see word_key)
+    uint64_t hash_seed;   // SEED of the hash function policy
+    uint64_t arena_bytes; // # of bytes of word chars
+    uint64_t reserved;    // 0 (room for later versions)
+};
+
+// returns the key of a word for the perfect hash with the given seed:
+// its hash by policy kind, remixed with seed
+uint64_t word_key(HashKind kind, uint64_t seed, std::string_view word);
+
+// returns the bucket (of numBuckets) of a word with key key
+size_t key_bucket(uint64_t key, size_t numBuckets);
+
+// returns the slot (of numWords) of a word with key key in a bucket
+// whose pilot is pilot
+size_t key_slot(uint64_t key, uint32_t pilot, size_t numWords);
+
+// builds a minimal perfect hash of words (which must be distinct and
+// non-empty) and writes it to path; returns false if the file can't
+// be written or no perfect hash was found (after a few seeds)
+bool write_perfect_hash(const std::vector<std::string_view>& words,
+                        const char* path, HashKind kind = WY_HASH);
+
+// builds a minimal perfect hash of the (distinct) whitespace separated
+// words of the dictionary file at dictPath and writes it to path;
+// returns false if either file can't be used or no perfect hash was
+// found
+bool build_perfect_hash(const char* dictPath, const char* path,
+                        HashKind kind = WY_HASH);
+
+// read-only hash table searched directly in a memory mapped perfect
+// hash file: exactly one slot is looked at per search, and the file
+// holds little more than the words themselves (5 bytes per word on
+// top of their chars)
+// (same public interface as HashSnapshot so the two are interchangeable)
+class PerfectHashTable
+{
+public:
+    typedef size_t size_type;
+    PerfectHashTable();
+    bool open(const char* path);
+    size_type cap() const;
+    size_type size() const;
+    bool search(std::string_view sWord) const;
+    double load_factor() const;
+    void scat_plot(std::ostream& out) const;
+    void grading_helper_print(std::ostream& out) const;
+private:
+    MappedFile file;
+    const uint32_t* pilots;  // pilot array inside the mapping
+    const uint32_t* offsets; // word offset array inside the mapping
+    const char* arena;       // string arena inside the mapping
+    size_type numWords;      // # of words (and slots)
+    size_type numBuckets;    // # of buckets (and pilots)
+    uint64_t seed;           // seed of the keys
+    HashKind hashKind;       // hash function policy of the file
+    std::string_view word_at(size_type i) const;
+
+    // disable copy construction & copy assignment
+    PerfectHashTable(const PerfectHashTable& src);
+    void operator=(const PerfectHashTable& rhs);
+};
+
+#endif
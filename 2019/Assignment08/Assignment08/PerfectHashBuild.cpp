@@ -0,0 +1,71 @@
+// FILE: PerfectHashBuild.cpp
+// Offline builder of minimal perfect hash files (see PerfectHash.h)
+// for static dictionaries, to be searched with PerfectHashTable
+// (kept separate from the Assign08 target since it has its own main;
+// build with e.g.
+//   g++ -std=c++17 -O2 PerfectHashBuild.cpp PerfectHash.cpp MappedFile.cpp TextScan.cpp
+// and run it as
+//   PerfectHashBuild dict1.txt [dict1.txt.phash]
+// the output file name defaults to the dictionary file name + .phash).
+// It reports the build time, the file size and the bytes per word
+// beyond the words' own chars, and checks that every dictionary word
+// can be found in the file.
+#include "PerfectHash.h"
+#include "TextScan.h"
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstring>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: PerfectHashBuild dictionary [output]" << endl;
+        return EXIT_FAILURE;
+    }
+    string outName = argc > 2 ? string(argv[2]) : string(argv[1]) + ".phash";
+    chrono::steady_clock::time_point beg = chrono::steady_clock::now();
+    if ( ! build_perfect_hash(argv[1], outName.c_str()) )
+    {
+        cerr << "Failed to build " << outName << " from " << argv[1] << endl;
+        return EXIT_FAILURE;
+    }
+    chrono::duration<double> took = chrono::steady_clock::now() - beg;
+
+    PerfectHashTable table;
+    MappedFile dict;
+    if ( ! table.open(outName.c_str()) || ! dict.open(argv[1]) )
+    {
+        cerr << "Failed to reopen " << outName << " or " << argv[1] << endl;
+        return EXIT_FAILURE;
+    }
+    size_t numChars = 0, missing = 0;
+    const char* p = skip_space(dict.begin(), dict.end());
+    while (p < dict.end())
+    {
+        const char* wordEnd = skip_word(p, dict.end());
+        missing += ! table.search(string_view(p, size_t(wordEnd - p)));
+        p = skip_space(wordEnd, dict.end());
+    }
+    MappedFile out; // (for the file's size and its header's arena size)
+    if ( ! out.open(outName.c_str()) || out.size() < sizeof(PerfectHeader) )
+    {
+        cerr << "Failed to reopen " << outName << endl;
+        return EXIT_FAILURE;
+    }
+    PerfectHeader header;
+    memcpy(&header, out.begin(), sizeof(header));
+    numChars = header.arena_bytes;
+    cout << outName << ": " << table.size() << " words, "
+         << out.size() << " bytes (" << double(out.size() - numChars) / table.size()
+         << " bytes/word beyond the chars), built in " << took.count()
+         << " seconds" << endl;
+    if (missing != 0)
+    {
+        cerr << missing << " dictionary words not found!" << endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+#include "RobinHoodHashTable.h"
+#include "ScatPlot.h"
+#include <utility>  // for use of swap
+using namespace std;
+
+// the table is grown once more than 9/10 of its slots are in use
+static const double MAX_LOAD = 0.9;
+
+// constructs an empty table whose capacity is the smallest power of 2
+// that is >= initial_capacity (and >= 16)
+RobinHoodHashTable::RobinHoodHashTable(size_type initial_capacity,
+                                       HashKind hash_kind)
+: capacity(16), used(0), hashKind(hash_kind)
+{
+    while (capacity < initial_capacity)
+        capacity *= 2;
+    data = new Item[capacity];
+    for (size_type i = 0; i < capacity; ++i)
+        data[i].dist = 0;
+}
+
+// returns dynamic memory used by the table to heap
+RobinHoodHashTable::~RobinHoodHashTable() { delete [] data; }
+
+// returns the table's current capacity
+RobinHoodHashTable::size_type RobinHoodHashTable::cap() const
+{ return capacity; }
+
+// returns the # of slots currently in use (non-vacant)
+RobinHoodHashTable::size_type RobinHoodHashTable::size() const
+{ return used; }
+
+// returns load-factor calculated as a fraction
+double RobinHoodHashTable::load_factor() const
+{ return double(used) / capacity; }
+
+// returns the longest probe distance of any word in the table
+// (0 if the table is empty)
+RobinHoodHashTable::size_type RobinHoodHashTable::max_distance() const
+{
+    size_type longest = 0;
+    for (size_type i = 0; i < capacity; ++i)
+        if (data[i].dist > longest)
+            longest = data[i].dist;
+    return longest;
+}
+
+// returns true if sWord already exists in the table, otherwise false
+// (found by hashing, with the same bounded probe as search)
+bool RobinHoodHashTable::exists(string_view sWord) const
+{ return find(sWord, hash_word(hashKind, sWord)) != capacity; }
+
+// returns the slot holding sWord (whose hash value is h), or capacity
+// if it's not in the table; the probe stops at the first slot whose
+// word is closer to its home than sWord would be at that slot
+// (every vacant slot qualifies, its distance being 0)
+RobinHoodHashTable::size_type
+RobinHoodHashTable::find(string_view sWord, uint64_t h) const
+{
+    size_type index = home_slot(h, capacity, FIBONACCI);
+    for (uint32_t dist = 1; data[index].dist >= dist; ++dist)
+    {
+        if (data[index].hash == h && data[index].word == sWord)
+            return index;
+        index = (index + 1) & (capacity - 1);
+    }
+    return capacity;
+}
+
+// returns true if sWord can be found in the table
+bool RobinHoodHashTable::search(string_view sWord) const
+{ return find(sWord, hash_word(hashKind, sWord)) != capacity; }
+
+// the word of item (whose hash is already set) is moved into the
+// table: walking from its home slot, it takes the first vacant slot
+// or the first slot whose word is closer to its own home, in which
+// case the displaced word carries on in its place
+// returns false (table unchanged) if the word turns out to be in the
+// table already: it would be met before the first displacement, at
+// the latest, which is where find stops too
+bool RobinHoodHashTable::place(Item& item)
+{
+    size_type index = home_slot(item.hash, capacity, FIBONACCI);
+    item.dist = 1;
+    bool displaced = false;
+    while (data[index].dist != 0)
+    {
+        if ( ! displaced && data[index].hash == item.hash
+             && data[index].word == item.word )
+            return false;
+        if (data[index].dist < item.dist) // Robin Hood: take from the rich
+        {
+            swap(data[index].word, item.word);
+            swap(data[index].hash, item.hash);
+            swap(data[index].dist, item.dist);
+            displaced = true;
+        }
+        index = (index + 1) & (capacity - 1);
+        ++item.dist;
+    }
+    data[index].word = std::move(item.word);
+    data[index].hash = item.hash;
+    data[index].dist = item.dist;
+    ++used;
+    return true;
+}
+
+// if sWord is not in the table yet, it is inserted into the table and
+// true is returned, otherwise false is returned (if the insertion
+// results in the load-factor exceeding MAX_LOAD, rehash is called to
+// double the capacity)
+bool RobinHoodHashTable::insert(string_view sWord)
+{
+    Item item;
+    item.word = sWord;
+    item.hash = hash_word(hashKind, sWord);
+    if ( ! place(item) )
+        return false;
+    if (load_factor() > MAX_LOAD)
+        rehash();
+    return true;
+}
+
+// removes sWord from the table if it's there (returning true, false
+// otherwise); the words following it that aren't in their home slot
+// are shifted back one slot each (backward-shift deletion), which
+// keeps every probe sequence intact without tombstones
+bool RobinHoodHashTable::erase(string_view sWord)
+{
+    size_type index = find(sWord, hash_word(hashKind, sWord));
+    if (index == capacity)
+        return false;
+    size_type next = (index + 1) & (capacity - 1);
+    while (data[next].dist > 1)
+    {
+        data[index].word = std::move(data[next].word);
+        data[index].hash = data[next].hash;
+        data[index].dist = data[next].dist - 1;
+        index = next;
+        next = (next + 1) & (capacity - 1);
+    }
+    data[index].word.clear();
+    data[index].dist = 0;
+    --used;
+    return true;
+}
+
+// a new table twice the size replaces the old one and every word is
+// moved (not copied) into it (the stored hashes are reused)
+void RobinHoodHashTable::rehash()
+{
+    Item* oldData = data;
+    size_type oldCap = capacity;
+    capacity *= 2;
+    used = 0;
+    data = new Item[capacity];
+    for (size_type i = 0; i < capacity; ++i)
+        data[i].dist = 0;
+    for (size_type i = 0; i < oldCap; ++i)
+        if (oldData[i].dist != 0)
+            place(oldData[i]);
+    delete [] oldData;
+}
+
+// graphs a horizontal histogram that gives a decent idea of how
+// items are distributed over the table
+void RobinHoodHashTable::scat_plot(ostream& out) const
+{
+    plot_slots(out, capacity, [this](size_type i) { return data[i].dist != 0; });
+}
+
+// dumping to out contents of "segment of slots" of the table
+void RobinHoodHashTable::grading_helper_print(ostream& out) const
+{
+    out << endl << "Content of selected hash table segment:\n";
+    for (size_type i = 10; i < 30 && i < capacity; ++i)
+        out << '[' << i << "]: " << data[i].word << endl;
+}
@@ -0,0 +1,60 @@
+#ifndef ROBIN_HOOD_HASH_TABLE
+#define ROBIN_HOOD_HASH_TABLE
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint32_t, uint64_t
+#include <iostream>    // for use of ostream
+#include <string>      // for use of string
+#include <string_view> // for use of string_view
+#include "HashFunctions.h"
+
+// open-addressing hash table using Robin Hood linear probing: every
+// slot records its word's probe distance (1 = in its home slot), and
+// an insert takes the slot of any word that is closer to its home than
+// the word being inserted (which then continues with the displaced
+// word); probe distances thus stay short and even, so that
+//   - a search can stop as soon as it meets a slot whose distance is
+//     less than its own (a miss costs about as much as a hit)
+//   - erase shifts the following displaced words back one slot
+//     (no tombstones are needed)
+// (same public interface as HashTable so the two are interchangeable)
+class RobinHoodHashTable
+{
+public:
+    typedef size_t size_type;
+    static const size_type INIT_CAP = 128;
+    // default | 1-argument | 2-argument constructor
+    RobinHoodHashTable(size_type initial_capacity = INIT_CAP,
+                       HashKind hash_kind = WY_HASH);
+    ~RobinHoodHashTable();
+    size_type cap() const;
+    size_type size() const;
+    bool exists(std::string_view sWord) const;
+    bool search(std::string_view sWord) const;
+    double load_factor() const;
+    size_type max_distance() const;
+    void scat_plot(std::ostream& out) const;
+    void grading_helper_print(std::ostream& out) const;
+    bool insert(std::string_view sWord);
+    bool erase(std::string_view sWord);
+private:
+    struct Item
+    {
+        std::string word;  // word as string
+        uint64_t hash;     // hash value of word
+        uint32_t dist;     // probe distance (0 if the slot is vacant)
+    };
+    Item* data;
+    size_type capacity; // # of slots (power of 2)
+    size_type used;     // # of slots in use (non-vacant)
+    HashKind hashKind;  // hash function policy
+    size_type find(std::string_view sWord, uint64_t h) const;
+    bool place(Item& item);
+    void rehash();
+
+    // disable copy construction & copy assignment
+    RobinHoodHashTable(const RobinHoodHashTable& src);
+    void operator=(const RobinHoodHashTable& rhs);
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SCAT_PLOT
+#define SCAT_PLOT
+
+#include <cstdlib>  // for use of size_t
+#include <iostream> // for use of ostream
+#include <iomanip>  // for use of setw
+#include <cmath>    // for use of floor, log10
+#include <vector>   // for use of vector
+
+// returns the # of slots per row of the scatter plot of a hash table
+// with the given capacity
+inline size_t plot_width(size_t capacity)
+{
+    if (capacity >= 100000)
+        return capacity / 250;
+    else if (capacity >= 10000)
+        return capacity / 25;
+    else
+        return capacity / 10;
+}
+
+// returns, for each row of the scatter plot of a hash table with the
+// given capacity, the # of slots in that row that are in use (those
+// slots i for which in_use(i) returns true)
+template <class InUse>
+std::vector<size_t> slot_rows(size_t capacity, InUse in_use)
+{
+    size_t width = plot_width(capacity);
+    std::vector<size_t> rows((capacity + width - 1) / width, 0);
+    for (size_t i = 0; i < capacity; ++i)
+        if ( in_use(i) )
+            ++rows[i / width];
+    return rows;
+}
+
+// graphs a horizontal histogram that gives a decent idea of how the
+// slots of a hash table with the given capacity that are in use
+// (those slots i for which in_use(i) returns true) are distributed
+// (shared by the scat_plot member of each hash table engine)
+template <class InUse>
+void plot_slots(std::ostream& out, size_t capacity, InUse in_use)
+{
+    using namespace std;
+    out << endl << "Scatter plot of where hash table is used:";
+    vector<size_t> rows = slot_rows(capacity, in_use);
+    size_t lo_index = 0,
+    hi_index = capacity - 1,
+    width = plot_width(capacity);
+    size_t max_digits = size_t( floor( log10(hi_index) ) + 1 ),
+    label_beg  = lo_index,
+    label_end  = label_beg + width - 1;
+    for(label_beg = lo_index; label_beg <= hi_index; label_beg += width)
+    {
+        out << endl;
+        if( label_end > hi_index)
+            out << setw(max_digits) << label_beg << " - " << setw(max_digits) << hi_index << ": ";
+        else
+            out << setw(max_digits) << label_beg << " - " << setw(max_digits) << label_end << ": ";
+        out << string(rows[label_beg / width], '*');
+        label_end = label_end + width;
+    }
+    out << endl << endl;
+}
+
+#endif
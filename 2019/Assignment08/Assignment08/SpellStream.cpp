@@ -0,0 +1,247 @@
+#include "SpellStream.h"
+#include "TextScan.h"
+#include <cstring>            // for use of memchr, memcpy
+#include <deque>              // for use of deque
+#include <memory>             // for use of unique_ptr
+#include <string>             // for use of string
+#include <vector>             // for use of vector
+#include <thread>             // for use of thread
+#include <mutex>              // for use of mutex, unique_lock
+#include <condition_variable> // for use of condition_variable
+using namespace std;
+
+// a word of a block that wasn't found, and how many newlines of the
+// block come before it (with the block position of the last one's
+// successor, where the word's line starts, if there are any)
+struct BlockMiss
+{
+    uint32_t pos;       // block position of the word
+    uint32_t length;    // # of chars of the word
+    uint32_t newlines;  // # of newlines of the block before the word
+    uint32_t lineStart; // block position of the word's line, if newlines
+};
+
+// a block of text together with the results of checking it
+struct TextBlock
+{
+    vector<char> chars;      // the text (lowercased once checked)
+    size_t size;             // # of bytes of text in chars
+    uint64_t offset;         // text offset of chars[0]
+    vector<string_view> words;
+    unique_ptr<bool[]> found;
+    size_t foundCap;         // # of elements of found
+    vector<BlockMiss> misses;
+    uint64_t newlines;       // # of newlines in the block
+    size_t lastLineStart;    // block position after the last newline
+    bool done;               // true once checked
+    TextBlock() : size(0), offset(0), foundCap(0), newlines(0),
+                  lastLineStart(0), done(false) { }
+};
+
+// returns true if c is an ASCII letter
+static inline bool is_letter(char c)
+{ return (unsigned char)((c | 0x20) - 'a') < 26; }
+
+// newlines is increased by the # of newlines in [p, end) and lineStart
+// set to the position (relative to beg) after the last of them, if any
+static void count_newlines(const char* beg, const char* p, const char* end,
+                           uint64_t& newlines, size_t& lineStart)
+{
+    while (const char* nl = static_cast<const char*>(memchr(p, '\n', size_t(end - p))))
+    {
+        ++newlines;
+        lineStart = size_t(nl + 1 - beg);
+        p = nl + 1;
+    }
+}
+
+// lowercases and tokenizes the text of block, searches its words in
+// dict and records the ones not found (a worker's share of the job)
+static void check_block(const HashTable& dict, TextBlock& block)
+{
+    char* beg = block.chars.data();
+    char* end = beg + block.size;
+    lower_ascii(beg, end);
+    block.words.clear();
+    const char* p = skip_nonletters(beg, end);
+    while (p < end)
+    {
+        const char* wordEnd = skip_letters(p, end);
+        block.words.push_back(string_view(p, size_t(wordEnd - p)));
+        p = skip_nonletters(wordEnd, end);
+    }
+    if (block.foundCap < block.words.size())
+    {
+        block.foundCap = block.words.size();
+        block.found.reset(new bool[block.foundCap]);
+    }
+    dict.search_batch(block.words.data(), block.words.size(), block.found.get());
+
+    block.misses.clear();
+    block.newlines = 0;
+    block.lastLineStart = 0;
+    const char* scanned = beg;
+    for (size_t i = 0; i < block.words.size(); ++i)
+    {
+        if (block.found[i])
+            continue;
+        const char* word = block.words[i].data();
+        count_newlines(beg, scanned, word, block.newlines, block.lastLineStart);
+        scanned = word;
+        BlockMiss miss = { uint32_t(word - beg), uint32_t(block.words[i].length()),
+                           uint32_t(block.newlines), uint32_t(block.lastLineStart) };
+        block.misses.push_back(miss);
+    }
+    count_newlines(beg, scanned, end, block.newlines, block.lastLineStart);
+}
+
+// the worker threads and the queue of blocks they take their work
+// from; closing the pool (done by the destructor too, so that the
+// threads are joined if a report throws) lets the workers finish the
+// queued blocks and waits for them
+class BlockPool
+{
+public:
+    BlockPool(const HashTable& dict, unsigned numThreads)
+    : closing(false)
+    {
+        for (unsigned t = 0; t < numThreads; ++t)
+            threads.push_back(thread([this, &dict] { work(dict); }));
+    }
+    ~BlockPool() { close(); }
+    // queues block to be checked
+    void submit(TextBlock* block)
+    {
+        lock_guard<mutex> lock(m);
+        block->done = false;
+        todo.push_back(block);
+        workReady.notify_one();
+    }
+    // waits for block to be checked
+    void wait(TextBlock* block)
+    {
+        unique_lock<mutex> lock(m);
+        blockDone.wait(lock, [block] { return block->done; });
+    }
+    void close()
+    {
+        {
+            lock_guard<mutex> lock(m);
+            closing = true;
+            workReady.notify_all();
+        }
+        for (size_t t = 0; t < threads.size(); ++t)
+            if (threads[t].joinable())
+                threads[t].join();
+    }
+private:
+    void work(const HashTable& dict)
+    {
+        unique_lock<mutex> lock(m);
+        for ( ; ; )
+        {
+            workReady.wait(lock, [this] { return closing || ! todo.empty(); });
+            if (todo.empty())
+                return;
+            TextBlock* block = todo.front();
+            todo.pop_front();
+            lock.unlock();
+            check_block(dict, *block);
+            lock.lock();
+            block->done = true;
+            blockDone.notify_all();
+        }
+    }
+    vector<thread> threads;
+    mutex m;
+    condition_variable workReady, blockDone;
+    deque<TextBlock*> todo;
+    bool closing;
+};
+
+// (the calling thread reads block after block, carrying the partial
+// word at the end of each over to the next, and hands them to the
+// pool; once all blocks are in flight it waits for the oldest, reports
+// its misses and reuses it; the line and column of a miss come from
+// the newlines counted by the worker within the block and the line
+// the block starts in, which is known once the blocks before it are
+// reported)
+SpellStreamTotals spell_check_stream(const HashTable& dict, istream& in,
+    const function<void(const Misspelling&)>& report, unsigned numThreads)
+{
+    if (numThreads == 0)
+        numThreads = thread::hardware_concurrency();
+    if (numThreads == 0)
+        numThreads = 1;
+    SpellStreamTotals totals = { 0, 0, 0 };
+    vector<unique_ptr<TextBlock>> blocks(numThreads * MAX_BLOCKS_PER_THREAD);
+    for (size_t b = 0; b < blocks.size(); ++b)
+        blocks[b].reset(new TextBlock);
+    vector<TextBlock*> idle;
+    for (size_t b = 0; b < blocks.size(); ++b)
+        idle.push_back(blocks[b].get());
+    deque<TextBlock*> inFlight; // in text order
+    uint64_t line = 1, lineOffset = 0; // line (and its offset) reported up to
+
+    BlockPool pool(dict, numThreads);
+    auto report_oldest = [&]()
+    {
+        TextBlock* block = inFlight.front();
+        inFlight.pop_front();
+        pool.wait(block);
+        for (size_t i = 0; i < block->misses.size(); ++i)
+        {
+            const BlockMiss& miss = block->misses[i];
+            Misspelling m;
+            m.word = string_view(block->chars.data() + miss.pos, miss.length);
+            m.offset = block->offset + miss.pos;
+            m.line = line + miss.newlines;
+            m.column = miss.newlines > 0 ? miss.pos - miss.lineStart + 1
+                                         : m.offset - lineOffset + 1;
+            report(m);
+        }
+        line += block->newlines;
+        if (block->newlines > 0)
+            lineOffset = block->offset + block->lastLineStart;
+        totals.words += block->words.size();
+        totals.misspelled += block->misses.size();
+        idle.push_back(block);
+    };
+
+    string carry; // partial word at the end of the last block read
+    uint64_t offset = 0;
+    while (in)
+    {
+        if (idle.empty())
+            report_oldest();
+        TextBlock* block = idle.back();
+        block->chars.resize(carry.size() + BLOCK_SIZE);
+        memcpy(block->chars.data(), carry.data(), carry.size());
+        in.read(block->chars.data() + carry.size(), streamsize(BLOCK_SIZE));
+        size_t size = carry.size() + size_t(in.gcount());
+        carry.clear();
+        if (size == 0)
+            break;
+        if (in) // Not the last block: its partial word goes to the next
+        {
+            size_t cut = size;
+            while (cut > 0 && is_letter(block->chars[cut - 1]))
+                --cut;
+            if (cut > 0) // (a block of letters only is cut as it is)
+            {
+                carry.assign(block->chars.data() + cut, size - cut);
+                size = cut;
+            }
+        }
+        block->size = size;
+        block->offset = offset;
+        offset += size;
+        totals.bytes += size;
+        idle.pop_back();
+        inFlight.push_back(block);
+        pool.submit(block);
+    }
+    while ( ! inFlight.empty() )
+        report_oldest();
+    return totals;
+}
@@ -0,0 +1,50 @@
+#ifndef SPELL_STREAM
+#define SPELL_STREAM
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint64_t
+#include <istream>     // for use of istream
+#include <string_view> // for use of string_view
+#include <functional>  // for use of function
+#include "HashTable.h"
+
+// STREAMING SPELL CHECK of running text against a HashTable dictionary:
+// the text is read in blocks of BLOCK_SIZE bytes (cut after the last
+// non-letter, the partial word at the end being carried over to the
+// next block), and each block is lowercased, tokenized into words of
+// ASCII letters and searched (HashTable::search_batch) by one of a pool
+// of worker threads while the calling thread reads the blocks that
+// follow; the words not found are reported in text order, with their
+// position, by the calling thread as the blocks are done
+// (at most MAX_BLOCKS_PER_THREAD blocks per worker are in flight, so
+// memory use doesn't depend on the size of the text)
+const size_t BLOCK_SIZE = 1 << 20;
+const unsigned MAX_BLOCKS_PER_THREAD = 2;
+
+// a word not found in the dictionary (lowercased; the view is only
+// valid during the call reporting it) and where it starts in the text
+struct Misspelling
+{
+    std::string_view word;
+    uint64_t offset;  // byte offset from the start of the text
+    uint64_t line;    // 1-based line #
+    uint64_t column;  // 1-based byte # within the line
+};
+
+// what a spell check went through
+struct SpellStreamTotals
+{
+    uint64_t bytes;       // bytes of text read
+    uint64_t words;       // words searched
+    uint64_t misspelled;  // words not found
+};
+
+// spell checks the text read from in (to its end) against dict on
+// numThreads worker threads (the # of hardware threads if 0), calling
+// report for each word not found, in text order; returns the totals
+// (dict must not be changed during the check)
+SpellStreamTotals spell_check_stream(const HashTable& dict, std::istream& in,
+    const std::function<void(const Misspelling&)>& report,
+    unsigned numThreads = 0);
+
+#endif
@@ -0,0 +1,256 @@
+#include "SpellSuggester.h"
+#include "HashFunctions.h"
+#include "MappedFile.h"
+#include "TextScan.h"
+#include <algorithm> // for use of sort, unique, lower_bound, stable_sort, fill
+#include <numeric>   // for use of iota
+#include <cstring>   // for use of memcpy, memmove
+using namespace std;
+
+// keys[] gets the hash of the len chars at s and of every string
+// obtained by deleting up to left more of them at positions >= from
+// (each set of deleted positions is visited once; equal strings may
+// still come up twice); each deletion is made, and undone, in place
+static void add_deletions(char* s, size_t len, size_t from, size_t left,
+                          vector<uint32_t>& keys)
+{
+    keys.push_back(uint32_t(WyHash()(string_view(s, len))));
+    if (left == 0)
+        return;
+    for (size_t i = from; i < len; ++i)
+    {
+        char c = s[i];
+        memmove(s + i, s + i + 1, len - i - 1);
+        add_deletions(s, len - 1, i, left - 1, keys);
+        memmove(s + i + 1, s + i, len - i - 1);
+        s[i] = c;
+    }
+}
+
+// sorts entries (key << 32 | word #) that are already in word # order
+// by key, keeping word # order among equal keys: a least significant
+// digit first radix sort of the key in 4 passes of 8 bits, which for
+// millions of entries is several times faster than a comparison sort
+static void sort_by_key(vector<uint64_t>& entries)
+{
+    const size_t DIGITS = 1 << 8;
+    vector<uint64_t> sorted(entries.size());
+    vector<size_t> start(DIGITS);
+    for (int shift = 32; shift < 64; shift += 8)
+    {
+        fill(start.begin(), start.end(), 0);
+        for (size_t i = 0; i < entries.size(); ++i)
+            ++start[(entries[i] >> shift) & (DIGITS - 1)];
+        size_t total = 0;
+        for (size_t d = 0; d < DIGITS; ++d)
+        {
+            size_t count = start[d];
+            start[d] = total;
+            total += count;
+        }
+        for (size_t i = 0; i < entries.size(); ++i)
+            sorted[start[(entries[i] >> shift) & (DIGITS - 1)]++] = entries[i];
+        entries.swap(sorted);
+    }
+}
+
+// constructs an empty suggester for words within max_distance edits
+// (at most MAX_DISTANCE)
+SpellSuggester::SpellSuggester(size_type max_distance)
+: maxDistance(max_distance < MAX_DISTANCE ? max_distance : MAX_DISTANCE),
+  begs(1, 0), built(true)
+{ }
+
+// maps the dictionary file at path into memory, adds each of its
+// whitespace separated words and builds the index
+// returns false (suggester unchanged) if the file can't be mapped
+bool SpellSuggester::load(const char* path)
+{
+    MappedFile file;
+    if ( ! file.open(path) )
+        return false;
+    const char* p = skip_space(file.begin(), file.end());
+    while (p < file.end())
+    {
+        const char* wordEnd = skip_word(p, file.end());
+        add(string_view(p, size_type(wordEnd - p)));
+        p = skip_space(wordEnd, file.end());
+    }
+    build();
+    return true;
+}
+
+// adds word to the words to suggest from (build must be called before
+// the next suggest)
+void SpellSuggester::add(string_view word)
+{
+    if (word.empty())
+        return;
+    chars.append(word.data(), word.length());
+    begs.push_back(uint32_t(chars.size()));
+    built = false;
+}
+
+// sorts the words added so far (dropping duplicates) and indexes each
+// of them under the hashes of its deletions
+void SpellSuggester::build()
+{
+    if (built)
+        return;
+    vector<uint32_t> order(size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+         { return word_at(a) < word_at(b); });
+    string sortedChars;
+    vector<uint32_t> sortedBegs(1, 0);
+    sortedChars.reserve(chars.size());
+    for (size_type i = 0; i < order.size(); ++i)
+    {
+        string_view word = word_at(order[i]);
+        if (i > 0 && word == word_at(order[i - 1]))
+            continue;
+        sortedChars.append(word.data(), word.length());
+        sortedBegs.push_back(uint32_t(sortedChars.size()));
+    }
+    chars.swap(sortedChars);
+    begs.swap(sortedBegs);
+    chars.shrink_to_fit();
+    begs.shrink_to_fit();
+
+    index.clear();
+    index.reserve(size() * (PREFIX_LENGTH * (PREFIX_LENGTH + 1) / 2 + 1));
+    vector<uint32_t> keys;
+    for (uint32_t i = 0; i < size(); ++i)
+    {
+        deletion_keys(word_at(i), keys);
+        for (size_type k = 0; k < keys.size(); ++k)
+            index.push_back(uint64_t(keys[k]) << 32 | i);
+    }
+    sort_by_key(index);
+    index.shrink_to_fit();
+    built = true;
+}
+
+// returns the # of (distinct) words to suggest from
+SpellSuggester::size_type SpellSuggester::size() const
+{ return begs.size() - 1; }
+
+// returns the # of (deletion, word) pairs in the index
+SpellSuggester::size_type SpellSuggester::index_size() const
+{ return index.size(); }
+
+// returns the # of bytes of heap memory held by the suggester
+SpellSuggester::size_type SpellSuggester::memory() const
+{
+    return chars.capacity() + begs.capacity() * sizeof(uint32_t)
+           + index.capacity() * sizeof(uint64_t);
+}
+
+// out is set to (up to) the k words closest to word (within the max
+// distance), closest first and alphabetically among equally close ones
+void SpellSuggester::suggest(string_view word, size_type k,
+                             vector<Suggestion>& out) const
+{
+    out.clear();
+    vector<uint32_t> keys, candidates;
+    deletion_keys(word, keys);
+    for (size_type i = 0; i < keys.size(); ++i)
+    {
+        uint64_t first = uint64_t(keys[i]) << 32;
+        vector<uint64_t>::const_iterator it =
+            lower_bound(index.begin(), index.end(), first);
+        for ( ; it != index.end() && (*it >> 32) == keys[i]; ++it)
+            candidates.push_back(uint32_t(*it));
+    }
+    sort(candidates.begin(), candidates.end()); // word # order is alphabetical
+    candidates.erase(unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+    for (size_type i = 0; i < candidates.size(); ++i)
+    {
+        string_view candidate = word_at(candidates[i]);
+        size_type lenDiff = candidate.length() > word.length()
+                            ? candidate.length() - word.length()
+                            : word.length() - candidate.length();
+        if (lenDiff > maxDistance)
+            continue;
+        size_type distance = edit_distance(word, candidate, maxDistance);
+        if (distance <= maxDistance)
+            out.push_back(Suggestion{ candidate, distance });
+    }
+    stable_sort(out.begin(), out.end(), [](const Suggestion& a, const Suggestion& b)
+                { return a.distance < b.distance; });
+    if (out.size() > k)
+        out.resize(k);
+}
+
+// returns word # i
+string_view SpellSuggester::word_at(uint32_t i) const
+{
+    return string_view(chars.data() + begs[i], begs[i + 1] - begs[i]);
+}
+
+// keys is set to the (distinct) hashes of the deletions word is
+// indexed / looked up under: its first PREFIX_LENGTH chars with up to
+// maxDistance of them deleted
+void SpellSuggester::deletion_keys(string_view word, vector<uint32_t>& keys) const
+{
+    keys.clear();
+    char prefix[PREFIX_LENGTH];
+    size_type len = word.length() < PREFIX_LENGTH ? word.length() : PREFIX_LENGTH;
+    memcpy(prefix, word.data(), len);
+    add_deletions(prefix, len, 0, maxDistance, keys);
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+}
+
+// (rows of the dynamic programming table are kept for the current and
+// the 2 previous chars of a, the latter for adjacent transpositions;
+// they live on the stack unless b is long; only the cells within
+// maxDistance of the diagonal are computed, those just outside it
+// are set to maxDistance + 1, and the search gives up once a whole
+// row exceeds maxDistance)
+size_t edit_distance(string_view a, string_view b, size_t maxDistance)
+{
+    const size_t STACK_COLS = 64;
+    size_t over = maxDistance + 1;
+    size_t cols = b.length() + 1;
+    if (a.length() > b.length() + maxDistance || b.length() > a.length() + maxDistance)
+        return over;
+    size_t stackRows[3 * STACK_COLS];
+    vector<size_t> heapRows;
+    size_t* prev2 = stackRows;
+    if (cols > STACK_COLS)
+    {
+        heapRows.resize(3 * cols);
+        prev2 = heapRows.data();
+    }
+    size_t* prev = prev2 + cols;
+    size_t* cur = prev + cols;
+    for (size_t j = 0; j < cols; ++j)
+        prev[j] = j;
+    for (size_t i = 1; i <= a.length(); ++i)
+    {
+        size_t lo = i > maxDistance ? i - maxDistance : 1;
+        size_t hi = i + maxDistance < cols - 1 ? i + maxDistance : cols - 1;
+        cur[lo - 1] = lo == 1 ? i : over;
+        size_t rowMin = cur[lo - 1];
+        for (size_t j = lo; j <= hi; ++j)
+        {
+            size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            size_t d = min(min(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+                d = min(d, prev2[j - 2] + 1);
+            cur[j] = d;
+            rowMin = min(rowMin, d);
+        }
+        if (hi + 1 < cols)
+            cur[hi + 1] = over;
+        if (rowMin > maxDistance)
+            return over;
+        size_t* oldest = prev2;
+        prev2 = prev;
+        prev = cur;
+        cur = oldest;
+    }
+    return prev[cols - 1] <= maxDistance ? prev[cols - 1] : over;
+}
@@ -0,0 +1,58 @@
+#ifndef SPELL_SUGGESTER
+#define SPELL_SUGGESTER
+
+#include <cstdlib>     // for use of size_t
+#include <cstdint>     // for use of uint32_t, uint64_t
+#include <string>      // for use of string
+#include <string_view> // for use of string_view
+#include <vector>      // for use of vector
+
+// spelling suggestions by symmetric deletion (the SymSpell approach):
+// every dictionary word is indexed under each string obtained by
+// deleting up to max_distance chars of its first PREFIX_LENGTH chars;
+// a misspelled word is looked up under its own deletions (of the same
+// kind) only, which finds every word within max_distance edits
+// (insertions, deletions, substitutions and adjacent transpositions)
+// without generating any of the (many more) insertions or
+// substitutions of the misspelled word
+//   - the index is a sorted array of (32-bit hash of a deletion,
+//     word #) pairs; deletions are not stored, hash collisions only
+//     add candidates, and every candidate's actual edit distance is
+//     checked before it is suggested
+//   - suggestions are ordered by edit distance, then alphabetically
+class SpellSuggester
+{
+public:
+    typedef size_t size_type;
+    static const size_type MAX_DISTANCE = 2;  // largest supported
+    static const size_type PREFIX_LENGTH = 7; // chars whose deletions are indexed
+    struct Suggestion
+    {
+        std::string_view word; // dictionary word (chars owned by the suggester)
+        size_type distance;    // # of edits from the misspelled word
+    };
+    // default | 1-argument constructor
+    SpellSuggester(size_type max_distance = MAX_DISTANCE);
+    bool load(const char* path);
+    void add(std::string_view word);
+    void build();
+    size_type size() const;
+    size_type index_size() const;
+    size_type memory() const;
+    void suggest(std::string_view word, size_type k,
+                 std::vector<Suggestion>& out) const;
+private:
+    size_type maxDistance;       // max # of edits of a suggestion
+    std::string chars;           // chars of all words, back to back
+    std::vector<uint32_t> begs;  // word i is chars [begs[i], begs[i+1])
+    std::vector<uint64_t> index; // (deletion hash << 32 | word #), sorted
+    bool built;                  // true if index reflects all words added
+    std::string_view word_at(uint32_t i) const;
+    void deletion_keys(std::string_view word, std::vector<uint32_t>& keys) const;
+};
+
+// returns the optimal string alignment (restricted Damerau-Levenshtein)
+// distance between a and b, or maxDistance + 1 if it exceeds maxDistance
+size_t edit_distance(std::string_view a, std::string_view b, size_t maxDistance);
+
+#endif
@@ -0,0 +1,211 @@
+#include "StripedHashTable.h"
+#include "ScatPlot.h"
+#include "TextScan.h"
+#include <algorithm> // for use of upper_bound
+#include <mutex>     // for use of lock_guard
+#include <thread>    // for use of thread
+using namespace std;
+
+// returns h mixed so that its upper bits depend on all bits of h (h
+// may be a djb2 hash, whose high bits are 0 for short words)
+static inline uint64_t mix(uint64_t h)
+{
+    return h * 0x9E3779B97F4A7C15ULL;
+}
+
+// constructs 2^segment_bits empty segments that hash with the given
+// policy, each with an equal share of initial_capacity (adjusted by
+// HashTable as usual)
+StripedHashTable::StripedHashTable(size_type initial_capacity,
+                                   HashKind hash_kind, Reduction reduction,
+                                   unsigned segment_bits)
+: segmentBits(segment_bits), hashKind(hash_kind)
+{
+    size_type numSegs = size_type(1) << segmentBits;
+    for (size_type s = 0; s < numSegs; ++s)
+        segs.push_back(unique_ptr<Segment>(
+            new Segment(initial_capacity / numSegs, hash_kind, reduction)));
+}
+
+// returns the segment of a word whose hash value is h: the top
+// segmentBits bits of the low half of mix(h), which depend on the low
+// 32 bits of h; not the top bits of mix(h), which FIBONACCI takes the
+// home slot from (the words of a segment would all share them, and
+// crowd into 1 / 2^segmentBits of its home slots), nor any bit it uses
+// until a segment has 2^32 slots
+StripedHashTable::size_type StripedHashTable::segment_of(uint64_t h) const
+{
+    return segmentBits == 0 ? 0 : size_type(uint32_t(mix(h)) >> (32 - segmentBits));
+}
+
+// returns the # of segments
+StripedHashTable::size_type StripedHashTable::segments() const
+{ return segs.size(); }
+
+// returns the total capacity of the segments
+StripedHashTable::size_type StripedHashTable::cap() const
+{
+    size_type total = 0;
+    for (size_type s = 0; s < segs.size(); ++s)
+    {
+        shared_lock<shared_mutex> lock(segs[s]->lock);
+        total += segs[s]->table.cap();
+    }
+    return total;
+}
+
+// returns the total # of words in the segments
+StripedHashTable::size_type StripedHashTable::size() const
+{
+    size_type total = 0;
+    for (size_type s = 0; s < segs.size(); ++s)
+    {
+        shared_lock<shared_mutex> lock(segs[s]->lock);
+        total += segs[s]->table.size();
+    }
+    return total;
+}
+
+// returns load-factor calculated as a fraction (over all segments)
+double StripedHashTable::load_factor() const
+{ return double(size()) / cap(); }
+
+// returns true if sWord already exists in the table
+// (found by hashing, in its segment only, like search)
+bool StripedHashTable::exists(string_view sWord) const
+{
+    uint64_t h = hash_word(hashKind, sWord);
+    const Segment& seg = *segs[segment_of(h)];
+    shared_lock<shared_mutex> lock(seg.lock);
+    return seg.table.search_hashed(sWord, h);
+}
+
+// returns true if sWord can be found in the table (searching its
+// segment, which other threads may search at the same time)
+bool StripedHashTable::search(string_view sWord) const
+{
+    uint64_t h = hash_word(hashKind, sWord);
+    const Segment& seg = *segs[segment_of(h)];
+    shared_lock<shared_mutex> lock(seg.lock);
+    return seg.table.search_hashed(sWord, h);
+}
+
+// if sWord is not in the table yet, it is copied into storage owned by
+// its segment and inserted there, and true is returned; otherwise false
+// is returned (only sWord's segment is locked, and only it may grow)
+// (an empty word is not inserted)
+bool StripedHashTable::insert(string_view sWord)
+{
+    if (sWord.empty())
+        return false;
+    uint64_t h = hash_word(hashKind, sWord);
+    Segment& seg = *segs[segment_of(h)];
+    lock_guard<shared_mutex> lock(seg.lock);
+    return seg.table.insert_hashed(sWord, h);
+}
+
+// removes sWord from its segment; returns false if it isn't there
+bool StripedHashTable::erase(string_view sWord)
+{
+    uint64_t h = hash_word(hashKind, sWord);
+    Segment& seg = *segs[segment_of(h)];
+    lock_guard<shared_mutex> lock(seg.lock);
+    return seg.table.erase_hashed(sWord, h);
+}
+
+// maps the dictionary file at path into memory and inserts each of its
+// whitespace separated words not already in the table, on numThreads
+// threads (the # of hardware threads if 0) that each tokenize and hash
+// one chunk of the file (split at whitespace) and add its words to
+// their segments LOAD_BATCH at a time per segment (one lock each); the
+// words are views into the mapping (kept open for the table's
+// lifetime); other threads may use the table during the load
+// returns false (table unchanged) if the file can't be mapped
+bool StripedHashTable::load(const char* path, unsigned numThreads)
+{
+    unique_ptr<MappedFile> file(new MappedFile);
+    if ( ! file->open(path) )
+        return false;
+    if (numThreads == 0)
+        numThreads = thread::hardware_concurrency();
+    if (numThreads == 0)
+        numThreads = 1;
+    vector<const char*> bounds(numThreads + 1);
+    bounds[0] = file->begin();
+    bounds[numThreads] = file->end();
+    for (unsigned t = 1; t < numThreads; ++t)
+    {
+        const char* p = file->begin() + file->size() * t / numThreads;
+        bounds[t] = skip_word(p < bounds[t - 1] ? bounds[t - 1] : p, file->end());
+    }
+    struct Pending
+    {
+        string_view word;
+        uint64_t hash;
+    };
+    auto work = [&](unsigned t)
+    {
+        vector<vector<Pending>> pending(segs.size());
+        auto flush = [this, &pending](size_type s)
+        {
+            lock_guard<shared_mutex> lock(segs[s]->lock);
+            for (size_type i = 0; i < pending[s].size(); ++i)
+                segs[s]->table.insert_hashed(pending[s][i].word, pending[s][i].hash, false);
+            pending[s].clear();
+        };
+        const char* end = bounds[t + 1];
+        const char* p = skip_space(bounds[t], end);
+        while (p < end)
+        {
+            const char* wordEnd = skip_word(p, end);
+            string_view oneWord(p, size_type(wordEnd - p));
+            uint64_t h = hash_word(hashKind, oneWord);
+            size_type s = segment_of(h);
+            pending[s].push_back(Pending{ oneWord, h });
+            if (pending[s].size() == LOAD_BATCH)
+                flush(s);
+            p = skip_space(wordEnd, end);
+        }
+        for (size_type s = 0; s < segs.size(); ++s)
+            if ( ! pending[s].empty() )
+                flush(s);
+    };
+    vector<thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t)
+        threads.push_back(thread(work, t));
+    for (unsigned t = 0; t < numThreads; ++t)
+        threads[t].join();
+    lock_guard<mutex> lock(mappingsLock);
+    mappings.push_back(std::move(file));
+    return true;
+}
+
+// graphs a horizontal histogram that gives a decent idea of how
+// items are distributed over the table (the segments' slots one after
+// another); every segment is share-locked (in order, as no other
+// function holds more than one lock) for the whole plot, so that other
+// threads may search but not change the table meanwhile
+void StripedHashTable::scat_plot(ostream& out) const
+{
+    vector<shared_lock<shared_mutex>> locks;
+    vector<size_type> firstSlot(1, 0); // of each segment, and the end
+    for (size_type s = 0; s < segs.size(); ++s)
+    {
+        locks.push_back(shared_lock<shared_mutex>(segs[s]->lock));
+        firstSlot.push_back(firstSlot.back() + segs[s]->table.cap());
+    }
+    plot_slots(out, firstSlot.back(), [this, &firstSlot](size_type i)
+    {
+        size_type s = size_type(upper_bound(firstSlot.begin(), firstSlot.end(), i)
+                                - firstSlot.begin()) - 1;
+        return segs[s]->table.slot_in_use(i - firstSlot[s]);
+    });
+}
+
+// dumping to out contents of "segment of slots" of the table (of its
+// first segment)
+void StripedHashTable::grading_helper_print(ostream& out) const
+{
+    shared_lock<shared_mutex> lock(segs[0]->lock);
+    segs[0]->table.grading_helper_print(out);
+}
@@ -0,0 +1,71 @@
+#ifndef STRIPED_HASH_TABLE
+#define STRIPED_HASH_TABLE
+
+#include <cstdlib>      // for use of size_t
+#include <iostream>     // for use of ostream
+#include <memory>       // for use of unique_ptr
+#include <mutex>        // for use of mutex
+#include <shared_mutex> // for use of shared_mutex
+#include <string_view>  // for use of string_view
+#include <vector>       // for use of vector
+#include "HashTable.h"
+#include "MappedFile.h"
+
+// hash table that any number of threads may insert into (and search,
+// and erase from) at the same time: the words are split over
+// 2^segment_bits segments (at most 2^32) by bits of their (mixed) hash
+// values that the slot reduction doesn't use, and each segment is a HashTable of its own (same hash
+// function policy, reduction and quadratic probing, so a 1-segment
+// table behaves exactly like a HashTable) guarded by a reader-writer
+// lock of its own; threads updating different segments never wait for
+// one another, and a segment grows (rehash) on its own, holding up
+// only the threads that need that segment
+// (a word is hashed once: the hash value picks its segment and is
+// handed on to the segment's HashTable)
+// (same public interface as HashTable, for the parts that make sense
+// across segments, so the two are interchangeable in the driver)
+class StripedHashTable
+{
+public:
+    typedef size_t size_type;
+    static const size_type INIT_CAP = 101 * 64;
+    static const unsigned SEGMENT_BITS = 6;   // default: 64 segments
+    static const size_type LOAD_BATCH = 64;   // words added per lock by load
+    // default | 1-argument | 2-argument | 3-argument | 4-argument constructor
+    StripedHashTable(size_type initial_capacity = INIT_CAP,
+                     HashKind hash_kind = DJB2_HASH,
+                     Reduction reduction = PRIME_MOD,
+                     unsigned segment_bits = SEGMENT_BITS);
+    size_type cap() const;
+    size_type size() const;
+    size_type segments() const;
+    double load_factor() const;
+    bool exists(std::string_view sWord) const;
+    bool search(std::string_view sWord) const;
+    bool insert(std::string_view sWord);
+    bool erase(std::string_view sWord);
+    bool load(const char* path, unsigned numThreads = 0);
+    void scat_plot(std::ostream& out) const;
+    void grading_helper_print(std::ostream& out) const;
+private:
+    struct alignas(64) Segment
+    {
+        HashTable table;
+        mutable std::shared_mutex lock; // shared by searches
+        Segment(HashTable::size_type capacity, HashKind hash_kind,
+                Reduction reduction)
+        : table(capacity, hash_kind, reduction) { }
+    };
+    std::vector<std::unique_ptr<Segment>> segs;
+    unsigned segmentBits;
+    HashKind hashKind;  // hash function policy
+    std::vector<std::unique_ptr<MappedFile>> mappings; // files loaded
+    std::mutex mappingsLock;
+    size_type segment_of(uint64_t h) const;
+
+    // disable copy construction & copy assignment
+    StripedHashTable(const StripedHashTable& src);
+    void operator=(const StripedHashTable& rhs);
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include "TextScan.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// returns true if c is one of the whitespace characters
+static inline bool is_space(char c)
+{ return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+// returns true if c is an ASCII letter
+static inline bool is_letter(char c)
+{ return (unsigned char)((c | 0x20) - 'a') < 26; }
+
+#ifdef __SSE2__
+// returns a 16-bit mask whose bit i is set when p[i] is whitespace
+static inline unsigned space_mask(const char* p)
+{
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i blank = _mm_cmpeq_epi8(b, _mm_set1_epi8(' '));
+    __m128i ctrl = _mm_and_si128(_mm_cmpgt_epi8(b, _mm_set1_epi8('\t' - 1)),
+                                 _mm_cmplt_epi8(b, _mm_set1_epi8('\r' + 1)));
+    return unsigned(_mm_movemask_epi8(_mm_or_si128(blank, ctrl)));
+}
+
+// returns a 16-bit mask whose bit i is set when p[i] is a letter
+// (c | 0x20 folds capitals onto lowercase letters; subtracting 'a' and
+// biasing by 128 turns the unsigned test < 26 into a signed compare)
+static inline unsigned letter_mask(const char* p)
+{
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i folded = _mm_or_si128(b, _mm_set1_epi8(0x20));
+    __m128i biased = _mm_add_epi8(folded, _mm_set1_epi8(char(128 - 'a')));
+    return unsigned(_mm_movemask_epi8(
+        _mm_cmplt_epi8(biased, _mm_set1_epi8(char(-128 + 26)))));
+}
+
+// returns the index of the lowest set bit of a non-zero mask
+static inline unsigned lowest_bit(unsigned mask)
+{ return unsigned(__builtin_ctz(mask)); }
+#endif
+
+const char* skip_space(const char* p, const char* end)
+{
+#ifdef __SSE2__
+    while (end - p >= 16)
+    {
+        unsigned word = ~space_mask(p) & 0xFFFF;
+        if (word != 0)
+            return p + lowest_bit(word);
+        p += 16;
+    }
+#endif
+    while (p < end && is_space(*p))
+        ++p;
+    return p;
+}
+
+const char* skip_word(const char* p, const char* end)
+{
+#ifdef __SSE2__
+    while (end - p >= 16)
+    {
+        unsigned space = space_mask(p);
+        if (space != 0)
+            return p + lowest_bit(space);
+        p += 16;
+    }
+#endif
+    while (p < end && ! is_space(*p))
+        ++p;
+    return p;
+}
+
+const char* skip_nonletters(const char* p, const char* end)
+{
+#ifdef __SSE2__
+    while (end - p >= 16)
+    {
+        unsigned letter = letter_mask(p);
+        if (letter != 0)
+            return p + lowest_bit(letter);
+        p += 16;
+    }
+#endif
+    while (p < end && ! is_letter(*p))
+        ++p;
+    return p;
+}
+
+const char* skip_letters(const char* p, const char* end)
+{
+#ifdef __SSE2__
+    while (end - p >= 16)
+    {
+        unsigned other = ~letter_mask(p) & 0xFFFF;
+        if (other != 0)
+            return p + lowest_bit(other);
+        p += 16;
+    }
+#endif
+    while (p < end && is_letter(*p))
+        ++p;
+    return p;
+}
+
+void lower_ascii(char* p, char* end)
+{
+#ifdef __SSE2__
+    // 'A' .. 'Z' biased by 128 - 'A' are the 26 lowest signed bytes
+    const __m128i bias = _mm_set1_epi8(char(128 - 'A'));
+    const __m128i limit = _mm_set1_epi8(char(-128 + 26));
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    for ( ; end - p >= 16; p += 16)
+    {
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i upper = _mm_cmplt_epi8(_mm_add_epi8(b, bias), limit);
+        b = _mm_or_si128(b, _mm_and_si128(upper, caseBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), b);
+    }
+#endif
+    for ( ; p < end; ++p)
+        if (*p >= 'A' && *p <= 'Z')
+            *p = char(*p | 0x20);
+}
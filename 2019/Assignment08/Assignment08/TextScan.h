@@ -0,0 +1,29 @@
+#ifndef TEXT_SCAN
+#define TEXT_SCAN
+
+// in-place tokenizing of a character buffer into whitespace separated
+// words (whitespace being ' ', '\t', '\n', '\v', '\f' and '\r'); the
+// scanners examine 16 bytes per step with SSE2 when it is available
+
+// returns the address of the first non-whitespace byte in [p, end)
+// (end if there is none)
+const char* skip_space(const char* p, const char* end);
+
+// returns the address of the first whitespace byte in [p, end)
+// (end if there is none)
+const char* skip_word(const char* p, const char* end);
+
+// tokenizing of running text into words made of ASCII letters (every
+// other byte, punctuation and digits included, separates words), and
+// lowercasing in place; also 16 bytes per step with SSE2
+
+// returns the address of the first letter in [p, end) (end if none)
+const char* skip_nonletters(const char* p, const char* end);
+
+// returns the address of the first non-letter in [p, end) (end if none)
+const char* skip_letters(const char* p, const char* end);
+
+// turns the ASCII capital letters in [p, end) into lowercase ones
+void lower_ascii(char* p, char* end);
+
+#endif